@@ -275,7 +275,7 @@ namespace Base {
 			// ### MNA Section ###
         	///
         	void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
-        	virtual void mnaApplySystemMatrixStamp(Matrix& systemMatrix)=0;
+        	virtual void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix)=0;
         	virtual void mnaApplyRightSideVectorStamp(Matrix& rightVector)=0;
         	virtual void mnaPostStep(const Matrix& leftVector)=0;
 	};
@@ -16,6 +16,8 @@
 #include <vector>
 #include <experimental/filesystem>
 #include <dpsim-models/Logger.h>
+#include <dpsim-models/LoadProfile.h>
+#include <dpsim-models/LoadProfileStream.h>
 #include <dpsim-models/SystemTopology.h>
 #include <dpsim-models/SP/SP_Ph1_Load.h>
 #include <dpsim-models/DP/DP_Ph1_PQLoadCS.h>
@@ -38,6 +40,15 @@ namespace CPS {
 		std::map <String, String> mAssignPattern;
 		/// Skip first row if it has no digits at beginning
 		Bool mSkipFirstRow = true;
+		/// Profiles read so far, shared by all loads using the same file
+		std::map<String, LoadProfile::Ptr> mProfiles;
+		/// Window size of streamed csv profiles in samples, zero to read them completely
+		UInt mStreamWindowSize = 0;
+		/// Streams started so far, shared by all loads using the same file
+		std::map<String, LoadProfileStream::Ptr> mStreams;
+
+		/// Upper case alphanumeric part of a load or file name used for AUTO matching
+		static String normalizeName(const String& name);
 
 	public:
 		/// set load profile assigning pattern. AUTO for assigning load profile name (csv file name) to load object with the same name (mName)
@@ -63,9 +74,12 @@ namespace CPS {
 
 		///	convert HH:MM:SS format timestamp into total seconds.
 		///	e.g.: 00 : 01 : 00 -- > 60.
-		Real time_format_convert(const String& time);
+		static Real time_format_convert(const String& time);
 		/// Skip first row if it has no digits at beginning
 		void doSkipFirstRow(Bool value = true) { mSkipFirstRow = value; }
+		/// Stream csv load profiles through a window of the given number of
+		/// samples during the simulation instead of reading them beforehand
+		void setStreaming(UInt windowSize) { mStreamWindowSize = windowSize; }
 		///
 		MatrixRow csv2Eigen(const String& path);
 
@@ -97,6 +111,21 @@ namespace CPS {
 		std::vector<Real> readPQData (fs::path file,
 			Real start_time = -1, Real time_step = 1, Real end_time = -1,
 			CSVReader::DataFormat format = CSVReader::DataFormat::SECONDS);
+		/// Read a load profile from a csv file or a binary file written by
+		/// LoadProfile::writeBinary and sample it on a uniform time grid.
+		/// Every file is only read once, later calls return the same profile.
+		/// Binary profiles keep their own time grid.
+		LoadProfile::Ptr readProfile(fs::path file,
+			Real start_time = -1, Real time_step = 1, Real end_time = -1,
+			CSVReader::DataFormat format = CSVReader::DataFormat::SECONDS);
+		/// Start streaming a csv load profile, see setStreaming
+		LoadProfileStream::Ptr streamProfile(fs::path file,
+			Real start_time = -1, Real time_step = 1, Real end_time = -1,
+			CSVReader::DataFormat format = CSVReader::DataFormat::SECONDS);
+		/// Assign the profile of a file to a load, streamed or read completely
+		void assignProfile(std::shared_ptr<SP::Ph1::Load> load, fs::path file,
+			Real start_time, Real time_step, Real end_time,
+			CSVReader::DataFormat format = CSVReader::DataFormat::SECONDS);
 		/// assign load profile to corresponding load object
 		void assignLoadProfile(SystemTopology& sys,
 			Real start_time = -1, Real time_step = 1, Real end_time = -1,
@@ -23,6 +23,8 @@ namespace CPS {
 		MNAInterface::List mSubcomponentsAfterPostStep;
 
 		std::vector<CPS::Attribute<Matrix>::Ptr> mRightVectorStamps;
+		/// Set once a subcomponent stamp had values and they were all in mRightVectorRows
+		std::vector<Bool> mRightVectorStampChecked;
 
 		Bool mHasPreStep;
 		Bool mHasPostStep;
@@ -53,9 +55,13 @@ namespace CPS {
 		/// Initializes variables of components
 		void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) override;
 		/// Stamps system matrix
-		void mnaApplySystemMatrixStamp(Matrix& systemMatrix) override;
-		/// Stamps right side (source) vector
+		void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) override;
+		/// Stamps right side (source) vector, only touching the rows set by
+		/// mnaSetRightVectorRows if there are any
 		void mnaApplyRightSideVectorStamp(Matrix& rightVector) override;
+		/// Sets the rows of the right vector for this component and all
+		/// subcomponents, whose rows are a subset of them
+		void mnaSetRightVectorRows(const std::vector<UInt>& rows) override;
 		/// MNA pre step operations
 		void mnaPreStep(Real time, Int timeStepCount) override;
 		/// MNA post step operations
@@ -69,7 +75,7 @@ namespace CPS {
 		virtual void mnaParentInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) {
 			// By default, the parent has no custom initialization beyond what is done in CompositePowerComp::mnaInitialize
 		};
-		virtual void mnaParentApplySystemMatrixStamp(Matrix& systemMatrix) {
+		virtual void mnaParentApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 			// By default, the parent has no custom stamp on the system matrix, only the subcomponents are stamped
 		};
 		virtual void mnaParentApplyRightSideVectorStamp(Matrix& rightVector) {
@@ -0,0 +1,114 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <dpsim-models/Definitions.h>
+
+namespace CPS {
+
+	/// Discretized linear state space model dx/dt = A x + B u + C.
+	///
+	/// The transition matrices are computed once per (A, B, dt) instead of in
+	/// every step, as the Math::StateSpaceTrapezoidal and Math::StateSpaceEuler
+	/// functions do. With compile-time sizes all members are fixed-size Eigen
+	/// types, so a step does not allocate and small models are fully unrolled.
+	/// Passing Eigen::Dynamic for both sizes gives the same interface for
+	/// models whose size is only known at runtime.
+	template <int States, int Inputs>
+	class DiscreteStateSpace {
+	public:
+		enum class Method { Trapezoidal, Euler };
+
+		using StateVector = Eigen::Matrix<Real, States, 1>;
+		using InputVector = Eigen::Matrix<Real, Inputs, 1>;
+		using StateMatrix = Eigen::Matrix<Real, States, States>;
+		using InputMatrix = Eigen::Matrix<Real, States, Inputs>;
+
+		DiscreteStateSpace(Method method = Method::Trapezoidal) : mMethod(method) { }
+
+		/// Discretize A and B with time step dt and reset the constant term
+		template <typename MatA, typename MatB>
+		void setParameters(const Eigen::MatrixBase<MatA>& A, const Eigen::MatrixBase<MatB>& B, Real dt) {
+			Eigen::Index n = A.rows();
+			mTimeStep = dt;
+			if (mMethod == Method::Trapezoidal) {
+				// x(k+1) = (I - dt/2 A)^-1 [(I + dt/2 A) x(k) + dt B u + dt C]
+				StateMatrix F1 = StateMatrix::Identity(n, n) + (dt / 2.) * A;
+				StateMatrix F2 = StateMatrix::Identity(n, n) - (dt / 2.) * A;
+				StateMatrix F2inv = F2.partialPivLu().inverse();
+				mStateTransition.noalias() = F2inv * F1;
+				mInputScale = dt * F2inv;
+			} else {
+				// x(k+1) = (I + dt A) x(k) + dt B u + dt C
+				mInputScale = dt * StateMatrix::Identity(n, n);
+				mStateTransition = StateMatrix::Identity(n, n) + dt * A;
+			}
+			mOffset = StateVector::Zero(n);
+			setInputMatrix(B);
+		}
+
+		/// Discretize A, B and the constant term C with time step dt
+		template <typename MatA, typename MatB, typename MatC>
+		void setParameters(const Eigen::MatrixBase<MatA>& A, const Eigen::MatrixBase<MatB>& B,
+			const Eigen::MatrixBase<MatC>& C, Real dt) {
+			setParameters(A, B, dt);
+			setOffset(C);
+		}
+
+		/// Update B only, reusing the factorization of A
+		template <typename MatB>
+		void setInputMatrix(const Eigen::MatrixBase<MatB>& B) {
+			mInputTransition.noalias() = mInputScale * B;
+		}
+
+		/// Update C only, reusing the factorization of A
+		template <typename MatC>
+		void setOffset(const Eigen::MatrixBase<MatC>& C) {
+			mOffset.noalias() = mInputScale * C;
+		}
+
+		/// State after one step with input u held constant over the step
+		template <typename VecX, typename VecU>
+		StateVector step(const Eigen::MatrixBase<VecX>& x, const Eigen::MatrixBase<VecU>& u) const {
+			StateVector next = mOffset;
+			next.noalias() += mStateTransition * x;
+			next.noalias() += mInputTransition * u;
+			return next;
+		}
+
+		/// State after one step with input uOld at the start and uNew at the
+		/// end of the step. The trapezoidal rule uses their mean, forward
+		/// Euler only the input at the start.
+		template <typename VecX, typename VecU1, typename VecU2>
+		StateVector step(const Eigen::MatrixBase<VecX>& x, const Eigen::MatrixBase<VecU1>& uNew,
+			const Eigen::MatrixBase<VecU2>& uOld) const {
+			if (mMethod == Method::Euler)
+				return step(x, uOld);
+			InputVector u = 0.5 * (uNew + uOld);
+			return step(x, u);
+		}
+
+		Method method() const { return mMethod; }
+		Real timeStep() const { return mTimeStep; }
+		const StateMatrix& stateTransition() const { return mStateTransition; }
+		const InputMatrix& inputTransition() const { return mInputTransition; }
+
+	private:
+		Method mMethod;
+		Real mTimeStep = 0;
+		/// Maps x(k) to x(k+1)
+		StateMatrix mStateTransition;
+		/// Maps u to x(k+1)
+		InputMatrix mInputTransition;
+		/// Contribution of C to x(k+1)
+		StateVector mOffset;
+		/// Maps a derivative term to x(k+1), kept to update B and C cheaply
+		StateMatrix mInputScale;
+	};
+}
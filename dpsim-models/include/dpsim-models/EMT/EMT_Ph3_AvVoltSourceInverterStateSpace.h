@@ -9,6 +9,7 @@
 #pragma once
 
 #include <dpsim-models/Base/Base_Ph1_VoltageSource.h>
+#include <dpsim-models/DiscreteStateSpace.h>
 #include <dpsim-models/SimPowerComp.h>
 #include <dpsim-models/Solver/MNAInterface.h>
 
@@ -96,6 +97,8 @@ namespace Ph3 {
 		Matrix mB;
 		Matrix mC;
 		Matrix mD;
+		/// discretized state space model, updated with the linearized coefficients
+		DiscreteStateSpace<14, 6> mStateSpace;
 		// park transform matrix
 		Matrix mParkTransform;
 
@@ -140,7 +143,7 @@ namespace Ph3 {
 		/// Initializes internal variables of the component
 		void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
 		/// Stamps system matrix
-		void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
+		void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
 		/// Stamps right side (source) vector
 		void mnaApplyRightSideVectorStamp(Matrix& rightVector);
 		/// Update interface voltage from MNA system result
@@ -56,7 +56,7 @@ namespace Ph3 {
 		Matrix get_inverseParkTransformMatrix() const;
 		
         // ### MNA Section ###
-        void mnaApplySystemMatrixStamp(Matrix& systemMatrix) override;
+        void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) override;
         void mnaApplyRightSideVectorStamp(Matrix& rightVector) override;
 		void mnaPostStep(const Matrix& leftVector) override;
         void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
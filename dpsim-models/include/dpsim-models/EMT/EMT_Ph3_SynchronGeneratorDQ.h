@@ -88,7 +88,7 @@ namespace Ph3 {
 		///
 		void mnaApplyRightSideVectorStamp(Matrix& rightVector);
 		///
-		void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
+		void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
 
 		/// Retrieves calculated voltage from simulation for next step
 		virtual void mnaUpdateVoltage(const Matrix& leftVector);
@@ -0,0 +1,74 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <dpsim-models/Definitions.h>
+
+namespace CPS {
+	/// Load profile sampled on a uniform time grid.
+	///
+	/// The samples are stored as contiguous columns, either active and
+	/// reactive power or a weighting factor of the nominal power. A profile
+	/// is immutable and shared by all loads that use the same file. Profiles
+	/// read from the binary format are memory-mapped instead of copied.
+	class LoadProfile {
+	public:
+		using Ptr = std::shared_ptr<const LoadProfile>;
+
+		enum class Type { PQ, WeightingFactor };
+
+		/// File extension of the binary format
+		static const String BinaryExtension;
+
+		/// Takes ownership of the given columns, q is empty for weighting factors
+		LoadProfile(Type type, Real startTime, Real timeStep, std::vector<Real> values, std::vector<Real> q = {});
+
+		/// Maps a profile written by writeBinary into memory
+		static Ptr readBinary(const String& path);
+		/// Writes the profile in the binary format
+		void writeBinary(const String& path) const;
+
+		Type type() const { return mType; }
+		Real startTime() const { return mStartTime; }
+		Real timeStep() const { return mTimeStep; }
+		UInt size() const { return mSize; }
+
+		/// Sample index of the given time, clamped to the profile
+		UInt index(Real time) const {
+			Real pos = std::round((time - mStartTime) / mTimeStep);
+			if (!(pos > 0))
+				return 0;
+			return pos < mSize ? static_cast<UInt>(pos) : mSize - 1;
+		}
+		/// Active power [W] of a PQ profile
+		Real activePower(UInt idx) const { return mColumns[0][idx]; }
+		/// Reactive power [VAr] of a PQ profile
+		Real reactivePower(UInt idx) const { return mColumns[1][idx]; }
+		/// Weighting factor of the nominal power
+		Real weightingFactor(UInt idx) const { return mColumns[0][idx]; }
+
+	private:
+		LoadProfile() = default;
+
+		Type mType = Type::PQ;
+		Real mStartTime = 0;
+		Real mTimeStep = 1;
+		UInt mSize = 0;
+		/// Column data if the profile owns its samples
+		std::vector<Real> mData;
+		/// Memory mapping if the profile was read from a binary file
+		std::shared_ptr<void> mMapping;
+		/// First sample of each column, in mData or in the mapping
+		const Real* mColumns[2] = { nullptr, nullptr };
+	};
+}
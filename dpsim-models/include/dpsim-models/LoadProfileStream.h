@@ -0,0 +1,121 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <dpsim-models/LoadProfile.h>
+#include <dpsim-models/Logger.h>
+#include <dpsim-models/PowerProfile.h>
+
+namespace CPS {
+	class CSVReaderIterator;
+
+	/// Load profile read from a csv file while the simulation runs.
+	///
+	/// A background thread reads the file row by row and interpolates the
+	/// samples on a uniform time grid into a ring buffer of fixed size, so
+	/// the memory use does not depend on the length of the profile. The
+	/// samples are consumed in time order: a request for a sample that has
+	/// not been read yet spins briefly and then blocks until the thread has
+	/// read it, which is logged as an underrun. Samples more than a quarter
+	/// of the window behind the latest request may be overwritten. Loads
+	/// sharing a stream have to request the same times in each step.
+	class LoadProfileStream {
+	public:
+		using Ptr = std::shared_ptr<LoadProfileStream>;
+
+		/// Starts reading the file. Negative start or end times take the
+		/// first or last time in the file. Underruns are logged to log if given.
+		LoadProfileStream(const String& path, Real startTime, Real timeStep, Real endTime,
+			Bool hhmmss, Bool skipFirstRow, UInt windowSize, Logger::Log log = nullptr);
+		/// Stops the background thread
+		~LoadProfileStream();
+
+		LoadProfileStream(const LoadProfileStream&) = delete;
+		LoadProfileStream& operator=(const LoadProfileStream&) = delete;
+
+		LoadProfile::Type type() const { return mType; }
+		Real startTime() const { return mStartTime; }
+		Real timeStep() const { return mTimeStep; }
+		UInt windowSize() const { return mWindowSize; }
+		/// Number of samples that had not been read when they were requested
+		std::size_t underruns() const { return mUnderruns; }
+
+		/// Sample at the given time, waits until it has been read. For
+		/// weighting factor profiles only p is set.
+		PQData sample(Real time);
+
+	private:
+		/// Raw row of the file
+		struct Row {
+			Real time;
+			Real values[2];
+		};
+
+		/// Reads the next data row, returns false at the end of the file
+		Bool readRow(Row& row);
+		/// Interpolates the samples into the window, runs in mThread
+		void readAhead();
+		/// Wakes up sample if it waits for the reader
+		void notifySampler();
+		/// Waits until the sample with the given index has been read or the
+		/// reader has finished
+		void waitForSample(std::size_t idx, Real time);
+
+		/// Checks of the progress of the reader before sample blocks
+		static constexpr UInt SPIN_COUNT = 1000;
+
+		String mPath;
+		Logger::Log mSLog;
+		LoadProfile::Type mType = LoadProfile::Type::PQ;
+		Real mStartTime;
+		Real mTimeStep;
+		Real mEndTime;
+		Bool mHHMMSS;
+		UInt mWindowSize;
+		/// Samples behind the latest request that are kept
+		UInt mLookBehind;
+
+		std::ifstream mFile;
+		std::unique_ptr<CSVReaderIterator> mRows;
+		/// Rows around the sample being interpolated
+		Row mPrevRow;
+		Row mNextRow;
+		Bool mEndOfFile = false;
+
+		/// Samples of the window, two values per sample
+		std::vector<Real> mWindow;
+		/// Number of samples interpolated so far
+		std::atomic<std::size_t> mProduced { 0 };
+		/// Samples before this index may be overwritten
+		std::atomic<std::size_t> mReleased { 0 };
+		/// Set when all samples are in the window or reading failed
+		std::atomic<bool> mFinished { false };
+		std::atomic<bool> mRunning { false };
+		/// Set while the reader waits for free slots in the window
+		std::atomic<bool> mReaderWaiting { false };
+		/// Set while sample waits for the reader
+		std::atomic<bool> mSamplerWaiting { false };
+		/// Number of requests that had to wait for the reader
+		std::size_t mUnderruns = 0;
+		std::mutex mMutex;
+		std::condition_variable mSpaceAvailable;
+		std::condition_variable mSampleAvailable;
+		std::exception_ptr mError;
+		std::thread mThread;
+	};
+}
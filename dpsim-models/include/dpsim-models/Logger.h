@@ -31,7 +31,8 @@ namespace CPS {
 		using Log = std::shared_ptr<spdlog::logger>;
 
 	private:
-		static Log create(const std::string &name, Level filelevel = Level::info, Level clilevel = Level::off);
+		static Log create(const std::string &name, Level filelevel = Level::info, Level clilevel = Level::off,
+			Bool dedicated = false);
 
 	public:
 		Logger();
@@ -40,10 +41,18 @@ namespace CPS {
 		static String prefix();
 		static String logDir();
 		static void setLogDir(String path);
+		/// Writes all loggers into one file in the log directory instead of a file per
+		/// logger. Lines are prefixed with the logger name and written by a background thread.
+		static void setSharedLogFile(Bool shared);
+		/// Limits the number of dedicated log files open at the same time, further
+		/// loggers write into the shared log file. Zero disables the limit.
+		static void setMaxLogFiles(UInt count);
 
 		// #### SPD log wrapper ####
 		///
 		static Log get(const std::string &name, Level filelevel = Level::info, Level clilevel = Level::off);
+		/// Logger that always writes into its own file, e.g. for measurement data
+		static Log getDedicated(const std::string &name, Level filelevel = Level::info);
 		///
 		static void setLogLevel(std::shared_ptr<spdlog::logger> logger, Logger::Level level);
 		///
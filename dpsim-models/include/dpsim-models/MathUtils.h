@@ -71,6 +71,24 @@ namespace CPS {
 		static void addToMatrixElement(Matrix& mat, Matrix::Index row, Matrix::Index column, Real value);
 		static void addToMatrixElement(Matrix& mat, std::vector<UInt> rows, std::vector<UInt> columns, Real value);
 
+		// #### Sparse Matrix Operations ####
+		//
+		// Same layout as the dense operations above. Only the addressed
+		// coefficients are inserted, which keeps stamping proportional to
+		// the number of nonzeros instead of the system size.
+		static void setMatrixElement(SparseMatrixRow& mat, Matrix::Index row, Matrix::Index column, Complex value, Int maxFreq = 1, Int freqIdx = 0);
+
+		static void addToMatrixElement(SparseMatrixRow& mat, Matrix::Index row, Matrix::Index column, Complex value, Int maxFreq = 1, Int freqIdx = 0);
+
+		static void addToMatrixElement(SparseMatrixRow& mat, Matrix::Index row, Matrix::Index column, Matrix value, Int maxFreq = 1, Int freqIdx = 0);
+
+		static void setMatrixElement(SparseMatrixRow& mat, Matrix::Index row, Matrix::Index column, Real value);
+
+		static void addToMatrixElement(SparseMatrixRow& mat, std::vector<UInt> rows, std::vector<UInt> columns, Complex value);
+
+		static void addToMatrixElement(SparseMatrixRow& mat, Matrix::Index row, Matrix::Index column, Real value);
+		static void addToMatrixElement(SparseMatrixRow& mat, std::vector<UInt> rows, std::vector<UInt> columns, Real value);
+
 		// #### Integration Methods ####
 		static Matrix StateSpaceTrapezoidal(Matrix states, Matrix A, Matrix B, Real dt, Matrix u_new, Matrix u_old);
 		static Matrix StateSpaceTrapezoidal(Matrix states, Matrix A, Matrix B, Matrix C, Real dt, Matrix u_new, Matrix u_old);
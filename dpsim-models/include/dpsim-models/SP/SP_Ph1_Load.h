@@ -16,7 +16,8 @@
 #include <dpsim-models/SP/SP_Ph1_Capacitor.h>
 #include <dpsim-models/SP/SP_Ph1_Inductor.h>
 #include <dpsim-models/SP/SP_Ph1_Resistor.h>
-#include <dpsim-models/PowerProfile.h>
+#include <dpsim-models/LoadProfile.h>
+#include <dpsim-models/LoadProfileStream.h>
 
 namespace CPS {
 namespace SP {
@@ -50,6 +51,10 @@ namespace Ph1 {
 		Real mReactance;
 		/// Inductance [H]
 		Real mInductance;
+		/// Active power scaled by weighting factor profiles [Watt]
+		Real mNomActivePower = 0;
+		/// Reactive power scaled by weighting factor profiles [VAr]
+		Real mNomReactivePower = 0;
 		/// Capacitance [F]
 		Real mCapacitance;
 
@@ -74,9 +79,23 @@ namespace Ph1 {
 		/// Initializes component from power flow data
 		void initializeFromNodesAndTerminals(Real frequency) override;
 		/// Load profile data
-		PowerProfile mLoadProfile;
+		LoadProfile::Ptr mLoadProfile;
+		/// Load profile streamed during the simulation
+		LoadProfileStream::Ptr mLoadProfileStream;
 		/// Use the assigned load profile
 		bool use_profile = false;
+		/// Assign a load profile and use it
+		void setLoadProfile(LoadProfile::Ptr profile) {
+			mLoadProfile = profile;
+			mLoadProfileStream = nullptr;
+			use_profile = profile != nullptr;
+		}
+		/// Assign a streamed load profile and use it
+		void setLoadProfile(LoadProfileStream::Ptr profile) {
+			mLoadProfile = nullptr;
+			mLoadProfileStream = profile;
+			use_profile = profile != nullptr;
+		}
 		/// Update PQ for this load for power flow calculation at next time step
 		void updatePQ(Real time);
 
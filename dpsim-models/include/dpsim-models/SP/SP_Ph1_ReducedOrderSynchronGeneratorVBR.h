@@ -58,7 +58,7 @@ namespace Ph1 {
         // ### MNA Section ###
         ///
         void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
-        void mnaApplySystemMatrixStamp(Matrix& systemMatrix) override;
+        void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) override;
         void mnaApplyRightSideVectorStamp(Matrix& rightVector) override;      
         void mnaPostStep(const Matrix& leftVector) override;
         
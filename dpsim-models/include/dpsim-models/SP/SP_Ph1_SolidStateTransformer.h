@@ -75,7 +75,7 @@ namespace SP { namespace Ph1 {
     // /// Initializes internal variables of the component
     // void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
     // /// Stamps system matrix
-    // void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
+    // void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
     // /// Updates internal current variable of the component
     // void mnaUpdateCurrent(const Matrix& leftVector);
     // /// Updates internal voltage variable of the component
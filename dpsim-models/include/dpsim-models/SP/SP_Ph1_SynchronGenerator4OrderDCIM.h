@@ -9,6 +9,7 @@
 #pragma once
 
 #include <dpsim-models/Base/Base_ReducedOrderSynchronGenerator.h>
+#include <dpsim-models/DiscreteStateSpace.h>
 
 namespace CPS {
 namespace SP {
@@ -32,8 +33,10 @@ namespace Ph1 {
 		Matrix mB;
 		/// 
 		Matrix mC;
+		/// discretized state representation
+		DiscreteStateSpace<2, 2> mStateSpace;
 
-		///
+		/// calculate and discretize the state representation
 		void calculateStateMatrix();
 
 		/// Park Transformation
@@ -54,7 +57,7 @@ namespace Ph1 {
 
 		// ### MNA Section ###
         ///
-        void mnaApplySystemMatrixStamp(Matrix& systemMatrix) override;
+        void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) override;
         void mnaApplyRightSideVectorStamp(Matrix& rightVector) override;
         void mnaPostStep(const Matrix& leftVector) override;
 
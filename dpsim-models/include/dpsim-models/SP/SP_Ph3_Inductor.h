@@ -52,7 +52,7 @@ namespace CPS {
 				/// Initializes internal variables of the component
 				void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
 				/// Stamps system matrix
-				void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
+				void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
 				/// Upgrade values in the source vector and maybe system matrix before MNA solution
 				void mnaStep(Matrix& systemMatrix, Matrix& rightVector, Matrix& leftVector, Real time);
 				/// Upgrade internal variables after MNA solution
@@ -10,6 +10,7 @@
 
 #include <vector>
 
+#include <dpsim-models/DiscreteStateSpace.h>
 #include <dpsim-models/SimPowerComp.h>
 #include <dpsim-models/SimSignalComp.h>
 #include <dpsim-models/Task.h>
@@ -29,7 +30,9 @@ namespace Signal {
 		/// Nominal frequency
 		Real mOmegaNom;
 		/// Integration time step
-        Real mTimeStep;
+        Real mTimeStep = 0;
+		/// Set once A, B, C, D are composed from the parameters
+		Bool mComposed = false;
 
 		/// matrix A of state space model
 		Matrix mA = Matrix::Zero(2, 2);
@@ -39,6 +42,11 @@ namespace Signal {
 		Matrix mC = Matrix::Zero(2, 2);
 		/// matrix D of state space model
 		Matrix mD = Matrix::Zero(2, 2);
+		/// discretized state space model
+		DiscreteStateSpace<2, 2> mStateSpace;
+
+		/// Discretizes the state space model once it is composed and the time step is set
+		void discretize();
 
 	public:
 
@@ -61,7 +69,8 @@ namespace Signal {
 		PLL(String name, Logger::Level logLevel = Logger::Level::off);
 		/// Setter for PLL parameters
 		void setParameters(Real kpPLL, Real kiPLL, Real omegaNom);
-		/// Setter for simulation parameters
+		/// Setter for simulation parameters, discretizes the state space model
+		/// now or when it is composed
 		void setSimulationParameters(Real timestep);
 		/// Setter for initial values
         void setInitialValues(Real input_init, Matrix state_init, Matrix output_init);
@@ -10,6 +10,7 @@
 
 #include <vector>
 
+#include <dpsim-models/DiscreteStateSpace.h>
 #include <dpsim-models/SimPowerComp.h>
 #include <dpsim-models/SimSignalComp.h>
 #include <dpsim-models/Task.h>
@@ -58,6 +59,8 @@ namespace Signal {
 		Matrix mC = Matrix::Zero(2, 6);
 		/// matrix D of state space model
 		Matrix mD = Matrix::Zero(2, 6);
+		/// discretized state space model
+		DiscreteStateSpace<6, 6> mStateSpace;
 
 	public:
 
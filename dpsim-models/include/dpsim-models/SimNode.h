@@ -78,6 +78,8 @@ namespace CPS {
 		// #### MNA Section ####
 		///
 		void mnaUpdateVoltage(const Matrix& leftVector);
+		/// Updates the voltage from the solution vector in a separate task
+		void mnaInitialize(Attribute<Matrix>::Ptr leftVector);
 		///
 		void mnaInitializeHarm(std::vector<Attribute<Matrix>::Ptr> leftVector);
 		///
@@ -85,6 +87,20 @@ namespace CPS {
 		/// Return list of MNA tasks
 		const Task::List& mnaTasks();
 		///
+		class MnaPostStep : public Task {
+		public:
+			MnaPostStep(SimNode& node, Attribute<Matrix>::Ptr leftVector) :
+				Task(**node.mName + ".MnaPostStep"),
+				mNode(node), mLeftVector(leftVector) {
+				mAttributeDependencies.push_back(mLeftVector);
+				mModifiedAttributes.push_back(mNode.attribute("v"));
+			}
+			void execute(Real time, Int timeStepCount) { mNode.mnaUpdateVoltage(**mLeftVector); }
+		private:
+			SimNode& mNode;
+			Attribute<Matrix>::Ptr mLeftVector;
+		};
+		///
 		class MnaPostStepHarm : public Task {
 		public:
 			MnaPostStepHarm(SimNode& node, const std::vector<Attribute<Matrix>::Ptr> &leftVectors) :
@@ -32,16 +32,17 @@ namespace CPS {
 		virtual void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) {
 			mnaInitialize(omega, timeStep);
 		}
-		/// Stamps system matrix
-		virtual void mnaApplySystemMatrixStamp(Matrix& systemMatrix) { }
-		/// Stamps (sparse) system matrix
-		virtual void mnaApplySparseSystemMatrixStamp(SparseMatrixRow& systemMatrix) {
-			Matrix mat = Matrix(systemMatrix);
-			mnaApplySystemMatrixStamp(mat);
-			systemMatrix = mat.sparseView();
-		}
+		/// Stamps system matrix. Components only touch the coefficients they
+		/// contribute to, so the cost scales with the stamp's nonzeros.
+		virtual void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) { }
 		/// Stamps right side (source) vector
 		virtual void mnaApplyRightSideVectorStamp(Matrix& rightVector) { }
+		/// Adds the matrix node indices the right side vector stamp writes to
+		/// besides the ones of the terminals, virtual nodes and subcomponents
+		virtual void mnaAddRightVectorNodeIndices(std::vector<UInt>& indices) { }
+		/// Sets the rows of the right vector that the solver adds up, all
+		/// other rows have to stay zero. Empty if all rows are used.
+		virtual void mnaSetRightVectorRows(const std::vector<UInt>& rows) { mRightVectorRows = rows; }
 		/// Update interface voltage from MNA system result
 		virtual void mnaUpdateVoltage(const Matrix& leftVector) { }
 		/// Update interface current from MNA system result
@@ -61,7 +62,7 @@ namespace CPS {
 			mnaInitialize(omega, timeStep);
 		}
 		/// Stamps system matrix considering the frequency index
-		virtual void mnaApplySystemMatrixStampHarm(Matrix& systemMatrix, Int freqIdx) { }
+		virtual void mnaApplySystemMatrixStampHarm(SparseMatrixRow& systemMatrix, Int freqIdx) { }
 		/// Stamps right side (source) vector considering the frequency index
 		virtual void mnaApplyRightSideVectorStampHarm(Matrix& sourceVector) { }
 		virtual void mnaApplyRightSideVectorStampHarm(Matrix& sourceVector, Int freqIdx) { }
@@ -69,11 +70,27 @@ namespace CPS {
 		const Task::List& mnaTasks() {
 			return mMnaTasks;
 		}
+
+		/// Throws if the right vector stamp has values outside of the given
+		/// rows, which would be lost when only these rows are added up.
+		/// Returns false if the stamp has no values yet.
+		static Bool checkRightVectorRows(const Matrix& stamp, const std::vector<UInt>& rows, const String& name) {
+			Real rowsNorm = 0;
+			for (auto row : rows)
+				rowsNorm += stamp(row, 0) * stamp(row, 0);
+			Real norm = stamp.col(0).squaredNorm();
+			if (norm - rowsNorm > 1e-12 * norm)
+				throw SystemError("Right vector of " + name
+					+ " has values outside of the rows of its nodes, declare them in mnaAddRightVectorNodeIndices");
+			return norm > 0;
+		}
 	protected:
 		/// Every MNA component modifies its source vector attribute.
 		MNAInterface() : mRightVector(Attribute<Matrix>::createDynamic("right_vector", mAttributes)) { }
 
 		/// List of tasks that relate to using MNA for this component (usually pre-step and/or post-step)
 		Task::List mMnaTasks;
+		/// Rows of the right vector that the solver adds up, empty if all rows are used
+		std::vector<UInt> mRightVectorRows;
 	};
 }
@@ -477,29 +477,133 @@ std::vector<Real> CSVReader::readPQData(fs::path file,
 	return p_data;
 }
 
+String CSVReader::normalizeName(const String& name) {
+	String normalized;
+	for (auto c : name) {
+		if (isalnum(c))
+			normalized.push_back(toupper(c));
+	}
+	return normalized;
+}
+
+LoadProfile::Ptr CSVReader::readProfile(fs::path file,
+	Real start_time, Real time_step, Real end_time, CSVReader::DataFormat format) {
+
+	String key = file.string();
+	Bool binary = file.extension().string() == LoadProfile::BinaryExtension;
+	if (!binary)
+		key += fmt::format(":{}:{}:{}:{}", start_time, time_step, end_time, static_cast<int>(format));
+
+	auto cached = mProfiles.find(key);
+	if (cached != mProfiles.end())
+		return cached->second;
+
+	if (binary) {
+		auto profile = LoadProfile::readBinary(file.string());
+		mSLog->info("Mapped {} with {} samples", file.string(), profile->size());
+		return mProfiles[key] = profile;
+	}
+
+	// Read all samples into columns, assuming time,p,q or time,weighting factor
+	std::ifstream csvfile(file);
+	if (!csvfile)
+		throw SystemError("Cannot open load profile file " + file.string());
+	Bool need_that_conversion = format == DataFormat::HHMMSS;
+	CSVReaderIterator loop(csvfile);
+
+	// ignore the first row if it is a title
+	if (mSkipFirstRow && loop != CSVReaderIterator() && !std::isdigit((*loop).get(0)[0]))
+		loop.next();
+
+	std::vector<Real> times, values, q;
+	Bool data_with_weighting_factor = loop != CSVReaderIterator() && (*loop).size() == 2;
+	for (; loop != CSVReaderIterator(); loop.next()) {
+		if ((*loop).size() < (data_with_weighting_factor ? 2 : 3))
+			continue;
+		times.push_back(need_that_conversion ? time_format_convert((*loop).get(0)) : std::stod((*loop).get(0)));
+		if (data_with_weighting_factor) {
+			values.push_back(std::stod((*loop).get(1)));
+		} else {
+			// multiplied by 1000 due to unit conversion (kw to w)
+			values.push_back(std::stod((*loop).get(1)) * 1000);
+			q.push_back(std::stod((*loop).get(2)) * 1000);
+		}
+	}
+	if (times.empty())
+		throw SystemError("Load profile file " + file.string() + " contains no samples");
+
+	// Linear interpolation on the uniform grid, rows are sorted by time
+	Real start = start_time < 0 ? times.front() : start_time;
+	Real end = end_time < 0 ? times.back() : end_time;
+	UInt size = static_cast<UInt>(std::floor((end - start) / time_step + 1e-9)) + 1;
+	std::vector<Real> gridValues(size), gridQ(data_with_weighting_factor ? 0 : size);
+	std::size_t next = 0;
+	for (UInt idx = 0; idx < size; ++idx) {
+		Real x = start + idx * time_step;
+		while (next < times.size() && times[next] <= x)
+			++next;
+		std::size_t lower = next == 0 ? 0 : next - 1;
+		std::size_t upper = next == times.size() ? times.size() - 1 : next;
+		Real delta = upper == lower ? 0 : (x - times[lower]) / (times[upper] - times[lower]);
+		gridValues[idx] = delta * values[upper] + (1 - delta) * values[lower];
+		if (!data_with_weighting_factor)
+			gridQ[idx] = delta * q[upper] + (1 - delta) * q[lower];
+	}
+
+	auto profile = std::make_shared<const LoadProfile>(
+		data_with_weighting_factor ? LoadProfile::Type::WeightingFactor : LoadProfile::Type::PQ,
+		start, time_step, std::move(gridValues), std::move(gridQ));
+	mSLog->info("Read {} with {} samples", file.string(), profile->size());
+	return mProfiles[key] = profile;
+}
+
+LoadProfileStream::Ptr CSVReader::streamProfile(fs::path file,
+	Real start_time, Real time_step, Real end_time, CSVReader::DataFormat format) {
+
+	String key = fmt::format("{}:{}:{}:{}:{}", file.string(), start_time, time_step, end_time, static_cast<int>(format));
+	auto cached = mStreams.find(key);
+	if (cached != mStreams.end())
+		return cached->second;
+
+	auto stream = std::make_shared<LoadProfileStream>(file.string(), start_time, time_step, end_time,
+		format == DataFormat::HHMMSS, mSkipFirstRow, mStreamWindowSize, mSLog);
+	mSLog->info("Streaming {} through a window of {} samples", file.string(), stream->windowSize());
+	return mStreams[key] = stream;
+}
+
+void CSVReader::assignProfile(std::shared_ptr<SP::Ph1::Load> load, fs::path file,
+	Real start_time, Real time_step, Real end_time, CSVReader::DataFormat format) {
+
+	// Binary profiles are memory-mapped, so they are never streamed
+	if (mStreamWindowSize > 0 && file.extension().string() != LoadProfile::BinaryExtension)
+		load->setLoadProfile(streamProfile(file, start_time, time_step, end_time, format));
+	else
+		load->setLoadProfile(readProfile(file, start_time, time_step, end_time, format));
+}
+
 void CSVReader::assignLoadProfile(CPS::SystemTopology& sys, Real start_time, Real time_step, Real end_time,
 	CSVReader::Mode mode, CSVReader::DataFormat format) {
 
 	switch (mode) {
 		case CSVReader::Mode::AUTO: {
+			mSLog->info("Comparing csv file names with load mRIDs ...");
+			// Names are normalized once, binary files take precedence over csv files
+			std::map<String, fs::path> files;
+			for (auto file : mFileList) {
+				String extension = file.extension().string();
+				if (extension != ".csv" && extension != LoadProfile::BinaryExtension)
+					continue;
+				auto entry = files.emplace(normalizeName(file.stem().string()), file);
+				if (!entry.second && extension == LoadProfile::BinaryExtension)
+					entry.first->second = file;
+			}
 			for (auto obj : sys.mComponents) {
 				if (std::shared_ptr<CPS::SP::Ph1::Load> load = std::dynamic_pointer_cast<CPS::SP::Ph1::Load>(obj)) {
-					mSLog->info("Comparing csv file names with load mRIDs ...");
-					String load_name = load->name();
-					for (auto file : mFileList) {
-						String file_name = file.filename().string();
-						/// changing file name and load name to upper case for later matching
-						for (auto & c : load_name) c = toupper(c);
-						for (auto & c : file_name) c = toupper(c);
-						/// strip off all non-alphanumeric characters
-						load_name.erase(remove_if(load_name.begin(), load_name.end(), [](char c) { return !isalnum(c); }), load_name.end());
-						file_name.erase(remove_if(file_name.begin(), file_name.end(), [](char c) { return !isalnum(c); }), file_name.end());
-						if (std::string(file_name.begin(), file_name.end() - 3).compare(load_name) == 0) {
-							load->mLoadProfile = readLoadProfile(file, start_time, time_step, end_time, format);
-							load->use_profile = true;
-							mSLog->info("Assigned {} to {}", file.filename().string(), load->name());
-						}
-					}
+					auto file = files.find(normalizeName(load->name()));
+					if (file == files.end())
+						continue;
+					assignProfile(load, file->second, start_time, time_step, end_time, format);
+					mSLog->info("Assigned {} to {}", file->second.filename().string(), load->name());
 				}
 			}
 			break;
@@ -512,15 +616,15 @@ void CSVReader::assignLoadProfile(CPS::SystemTopology& sys, Real start_time, Rea
 				if (std::shared_ptr<CPS::SP::Ph1::Load> load = std::dynamic_pointer_cast<CPS::SP::Ph1::Load>(obj)) {
 					std::map<String, String>::iterator file = mAssignPattern.find(load->name());
 					if (file == mAssignPattern.end()) {
-						std::cout<< load->name()<<" has no profile given."<<std::endl;
 						mSLog->info("{} has no profile given.", load->name());
 						LP_not_assigned_counter++;
 						continue;
 					}
-					load->mLoadProfile = readLoadProfile(fs::path(mPath + file->second + ".csv"), start_time, time_step, end_time);
-					load->use_profile = true;
-					std::cout<<" Assigned "<< file->second<< " to " <<load->name()<<std::endl;
-					mSLog->info("Assigned {}.csv to {}", file->second, load->name());
+					fs::path path(mPath + file->second + LoadProfile::BinaryExtension);
+					if (!fs::exists(path))
+						path = fs::path(mPath + file->second + ".csv");
+					assignProfile(load, path, start_time, time_step, end_time);
+					mSLog->info("Assigned {} to {}", path.filename().string(), load->name());
 					LP_assigned_counter++;
 				}
 			}
@@ -61,7 +61,7 @@ void CompositePowerComp<VarType>::mnaInitialize(Real omega, Real timeStep, Attri
 }
 
 template <typename VarType>
-void CompositePowerComp<VarType>::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void CompositePowerComp<VarType>::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	for (auto subComp : mSubcomponentsMNA) {
 		subComp->mnaApplySystemMatrixStamp(systemMatrix);
 	}
@@ -70,15 +70,41 @@ void CompositePowerComp<VarType>::mnaApplySystemMatrixStamp(Matrix& systemMatrix
 
 template <typename VarType>
 void CompositePowerComp<VarType>::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
-	rightVector.setZero();
-	for (auto stamp : mRightVectorStamps) {
-		if ((**stamp).size() != 0) {
-			rightVector += **stamp;
+	if (this->mRightVectorRows.empty()) {
+		rightVector.setZero();
+		for (auto stamp : mRightVectorStamps) {
+			if ((**stamp).size() != 0) {
+				rightVector += **stamp;
+			}
+		}
+	} else {
+		for (auto row : this->mRightVectorRows)
+			rightVector(row, 0) = 0;
+		for (std::size_t i = 0; i < mRightVectorStamps.size(); ++i) {
+			const Matrix& subStamp = **mRightVectorStamps[i];
+			if (subStamp.size() == 0)
+				continue;
+			// Values outside of the rows would be lost, so every stamp is
+			// checked until it has values, in debug builds in every step
+#ifdef NDEBUG
+			if (!mRightVectorStampChecked[i])
+#endif
+				mRightVectorStampChecked[i] = MNAInterface::checkRightVectorRows(subStamp, this->mRightVectorRows, **this->mName);
+			for (auto row : this->mRightVectorRows)
+				rightVector(row, 0) += subStamp(row, 0);
 		}
 	}
 	mnaParentApplyRightSideVectorStamp(rightVector);
 }
 
+template <typename VarType>
+void CompositePowerComp<VarType>::mnaSetRightVectorRows(const std::vector<UInt>& rows) {
+	MNAInterface::mnaSetRightVectorRows(rows);
+	mRightVectorStampChecked.assign(mRightVectorStamps.size(), false);
+	for (auto subComp : mSubcomponentsMNA)
+		subComp->mnaSetRightVectorRows(rows);
+}
+
 template <typename VarType>
 void CompositePowerComp<VarType>::mnaPreStep(Real time, Int timeStepCount) {
 	for (auto subComp : mSubcomponentsBeforePreStep) {
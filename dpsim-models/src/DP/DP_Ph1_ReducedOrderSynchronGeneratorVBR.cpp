@@ -98,7 +98,7 @@ void DP::Ph1::ReducedOrderSynchronGeneratorVBR::mnaInitialize(Real omega,
 		mSLog->info("({}, {})", indexPair.first, indexPair.second);
 }
 
-void DP::Ph1::ReducedOrderSynchronGeneratorVBR::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void DP::Ph1::ReducedOrderSynchronGeneratorVBR::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	if (mModelAsCurrentSource) {
 		// Stamp conductance matrix
 		// set buttom right block
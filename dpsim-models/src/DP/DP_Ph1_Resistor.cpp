@@ -67,7 +67,7 @@ void DP::Ph1::Resistor::mnaInitializeHarm(Real omega, Real timeStep, std::vector
 	mMnaTasks.push_back(std::make_shared<MnaPostStepHarm>(*this, leftVectors));
 }
 
-void DP::Ph1::Resistor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void DP::Ph1::Resistor::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	Complex conductance = Complex(1. / **mResistance, 0);
 
 	for (UInt freq = 0; freq < mNumFreqs; freq++) {
@@ -94,7 +94,7 @@ void DP::Ph1::Resistor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
 	}
 }
 
-void DP::Ph1::Resistor::mnaApplySystemMatrixStampHarm(Matrix& systemMatrix, Int freqIdx) {
+void DP::Ph1::Resistor::mnaApplySystemMatrixStampHarm(SparseMatrixRow& systemMatrix, Int freqIdx) {
 	Complex conductance = Complex(1. / **mResistance, 0);
 	// Set diagonal entries
 	if (terminalNotGrounded(0))
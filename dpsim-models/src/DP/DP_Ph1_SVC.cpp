@@ -136,7 +136,7 @@ void DP::Ph1::SVC::mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::P
 	**mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
 }
 
-void DP::Ph1::SVC::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void DP::Ph1::SVC::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	mSubInductor->mnaApplySystemMatrixStamp(systemMatrix);
 	mSubCapacitor->mnaApplySystemMatrixStamp(systemMatrix);
 	mSubCapacitorSwitch->mnaApplySystemMatrixStamp(systemMatrix);
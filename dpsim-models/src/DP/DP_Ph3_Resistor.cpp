@@ -56,7 +56,7 @@ void DP::Ph3::Resistor::mnaInitialize(Real omega, Real timeStep, Attribute<Matri
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
 }
 
-void DP::Ph3::Resistor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void DP::Ph3::Resistor::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 
 	Matrix conductance = (**mResistance).inverse();
 
@@ -149,17 +149,18 @@ void EMT::Ph3::AvVoltSourceInverterStateSpace::initializeStates(Real omega, Real
 
 		mU <<
 			omega, **mPref, **mQref, initVgabc;
+
+		mStateSpace.setParameters(mA, mB, mTimeStep);
 }
 
 void EMT::Ph3::AvVoltSourceInverterStateSpace::updateStates() {
 
-	Matrix newStates = Matrix::Zero(14, 1);
-	Matrix newU = Matrix::Zero(6, 1);
+	DiscreteStateSpace<14, 6>::InputVector newU;
 
 	newU <<
 		mOmegaN, **mPref, **mQref, **mIntfVoltage;
 
-	newStates = Math::StateSpaceTrapezoidal(mStates, mA, mB, mTimeStep, newU, mU);
+	DiscreteStateSpace<14, 6>::StateVector newStates = mStateSpace.step(mStates, newU, mU);
 
 	// update states
 	**mThetaPLL = newStates(0, 0);
@@ -186,6 +187,7 @@ void EMT::Ph3::AvVoltSourceInverterStateSpace::updateStates() {
 
 	// update coefficients in A, B matrices due to linearization
 	updateLinearizedCoeffs();
+	mStateSpace.setParameters(mA, mB, mTimeStep);
 }
 
 void EMT::Ph3::AvVoltSourceInverterStateSpace::updateLinearizedCoeffs() {
@@ -286,7 +288,7 @@ void EMT::Ph3::AvVoltSourceInverterStateSpace::mnaInitialize(Real omega, Real ti
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
 	**mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
 }
-void EMT::Ph3::AvVoltSourceInverterStateSpace::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void EMT::Ph3::AvVoltSourceInverterStateSpace::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	// Apply matrix stamp for equivalent resistance
 	if (terminalNotGrounded(0)) {
 		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0, 0), matrixNodeIndex(0, 0), mYc);
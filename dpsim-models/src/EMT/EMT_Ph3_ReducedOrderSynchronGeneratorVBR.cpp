@@ -112,7 +112,7 @@ void EMT::Ph3::ReducedOrderSynchronGeneratorVBR::mnaInitialize(Real omega,
 		mSLog->info("({}, {})", indexPair.first, indexPair.second);
 }
 
-void EMT::Ph3::ReducedOrderSynchronGeneratorVBR::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void EMT::Ph3::ReducedOrderSynchronGeneratorVBR::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 
 	if (mModelAsCurrentSource) {
 		// Stamp conductance matrix
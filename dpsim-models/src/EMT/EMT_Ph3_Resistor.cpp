@@ -58,7 +58,7 @@ void EMT::Ph3::Resistor::mnaInitialize(Real omega, Real timeStep, Attribute<Matr
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
 }
 
-void EMT::Ph3::Resistor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void EMT::Ph3::Resistor::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 
 	Matrix conductance = (**mResistance).inverse();
 
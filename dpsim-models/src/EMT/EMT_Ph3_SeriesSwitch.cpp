@@ -58,7 +58,7 @@ void EMT::Ph3::SeriesSwitch::mnaInitialize(Real omega, Real timeStep, Attribute<
 
 Bool EMT::Ph3::SeriesSwitch::mnaIsClosed() { return **mIsClosed; }
 
-void EMT::Ph3::SeriesSwitch::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void EMT::Ph3::SeriesSwitch::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	Real conductance = (**mIsClosed)
 		? 1. / **mClosedResistance
 		: 1. / **mOpenResistance;
@@ -84,7 +84,7 @@ void EMT::Ph3::SeriesSwitch::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
 	}
 }
 
-void EMT::Ph3::SeriesSwitch::mnaApplySwitchSystemMatrixStamp(Bool closed, Matrix& systemMatrix, Int freqIdx) {
+void EMT::Ph3::SeriesSwitch::mnaApplySwitchSystemMatrixStamp(Bool closed, SparseMatrixRow& systemMatrix, Int freqIdx) {
 	Real conductance = (closed)
 		? 1. / **mClosedResistance
 		: 1. / **mOpenResistance;
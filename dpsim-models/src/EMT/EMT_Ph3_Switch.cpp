@@ -58,7 +58,7 @@ void EMT::Ph3::Switch::mnaInitialize(Real omega, Real timeStep, Attribute<Matrix
 
 Bool EMT::Ph3::Switch::mnaIsClosed() { return **mSwitchClosed; }
 
-void EMT::Ph3::Switch::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void EMT::Ph3::Switch::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	Matrix conductance = (**mSwitchClosed) ?
 		(**mClosedResistance).inverse() : (**mOpenResistance).inverse();
 
@@ -115,7 +115,7 @@ void EMT::Ph3::Switch::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
 		Logger::matrixToString(conductance));
 }
 
-void EMT::Ph3::Switch::mnaApplySwitchSystemMatrixStamp(Bool closed, Matrix& systemMatrix, Int freqIdx) {
+void EMT::Ph3::Switch::mnaApplySwitchSystemMatrixStamp(Bool closed, SparseMatrixRow& systemMatrix, Int freqIdx) {
 	Matrix conductance = (closed) ?
 		(**mClosedResistance).inverse() : (**mOpenResistance).inverse();
 
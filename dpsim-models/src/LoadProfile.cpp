@@ -0,0 +1,147 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim-models/LoadProfile.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+#ifdef __unix__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace CPS;
+
+const String LoadProfile::BinaryExtension = ".lpb";
+
+namespace {
+	/// Header of the binary format, followed by the columns as doubles in
+	/// native byte order
+	struct BinaryHeader {
+		char magic[8];
+		uint32_t version;
+		uint32_t type;
+		uint64_t size;
+		double startTime;
+		double timeStep;
+	};
+
+	const char binaryMagic[8] = { 'D', 'P', 'S', 'I', 'M', 'L', 'P', '\0' };
+	const uint32_t binaryVersion = 1;
+}
+
+LoadProfile::LoadProfile(Type type, Real startTime, Real timeStep, std::vector<Real> values, std::vector<Real> q) :
+	mType(type), mStartTime(startTime), mTimeStep(timeStep), mSize(static_cast<UInt>(values.size())) {
+
+	if (mSize == 0 || timeStep <= 0)
+		throw SystemError("Load profile requires samples and a positive time step");
+	if (type == Type::PQ && q.size() != values.size())
+		throw SystemError("Load profile requires the same number of active and reactive power samples");
+
+	mData = std::move(values);
+	if (type == Type::PQ)
+		mData.insert(mData.end(), q.begin(), q.end());
+	mColumns[0] = mData.data();
+	mColumns[1] = type == Type::PQ ? mData.data() + mSize : nullptr;
+}
+
+void LoadProfile::writeBinary(const String& path) const {
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file)
+		throw SystemError("Cannot open load profile file " + path);
+
+	BinaryHeader header;
+	std::memcpy(header.magic, binaryMagic, sizeof(binaryMagic));
+	header.version = binaryVersion;
+	header.type = static_cast<uint32_t>(mType);
+	header.size = mSize;
+	header.startTime = mStartTime;
+	header.timeStep = mTimeStep;
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	UInt columns = mType == Type::PQ ? 2 : 1;
+	for (UInt col = 0; col < columns; ++col)
+		file.write(reinterpret_cast<const char*>(mColumns[col]), mSize * sizeof(Real));
+	if (!file)
+		throw SystemError("Writing load profile file " + path + " failed");
+}
+
+LoadProfile::Ptr LoadProfile::readBinary(const String& path) {
+	BinaryHeader header;
+	std::shared_ptr<void> mapping;
+	const char* data = nullptr;
+	std::size_t length = 0;
+
+#ifdef __unix__
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		throw SystemError("Cannot open load profile file " + path, errno);
+	struct stat st;
+	if (fstat(fd, &st) != 0) {
+		close(fd);
+		throw SystemError("Cannot read load profile file " + path, errno);
+	}
+	length = static_cast<std::size_t>(st.st_size);
+	void* addr = length > 0 ? mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+	close(fd);
+	if (addr == MAP_FAILED)
+		throw SystemError("Cannot map load profile file " + path, errno);
+	mapping = std::shared_ptr<void>(addr, [length](void* ptr) { munmap(ptr, length); });
+	data = static_cast<const char*>(addr);
+#else
+	// Without mmap the file is read into a buffer of the same layout
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	if (!file)
+		throw SystemError("Cannot open load profile file " + path);
+	length = static_cast<std::size_t>(file.tellg());
+	auto buffer = std::make_shared<std::vector<Real>>((length + sizeof(Real) - 1) / sizeof(Real));
+	file.seekg(0);
+	file.read(reinterpret_cast<char*>(buffer->data()), length);
+	mapping = buffer;
+	data = reinterpret_cast<const char*>(buffer->data());
+#endif
+
+	if (length < sizeof(header))
+		throw SystemError("Load profile file " + path + " is truncated");
+	std::memcpy(&header, data, sizeof(header));
+	if (std::memcmp(header.magic, binaryMagic, sizeof(binaryMagic)) != 0 || header.version != binaryVersion)
+		throw SystemError("Load profile file " + path + " has an unknown format");
+	if (header.type != static_cast<uint32_t>(Type::PQ) && header.type != static_cast<uint32_t>(Type::WeightingFactor))
+		throw SystemError("Load profile file " + path + " has an unknown profile type");
+	// Also rejects a NaN time step
+	if (!(header.timeStep > 0))
+		throw SystemError("Load profile file " + path + " has no positive time step");
+
+	// The row count is checked against the file size before it is used, so
+	// that a corrupt header cannot overflow the expected size
+	UInt columns = header.type == static_cast<uint32_t>(Type::PQ) ? 2 : 1;
+	std::size_t rowBytes = columns * sizeof(Real);
+	if (header.size == 0 || header.size > std::numeric_limits<UInt>::max()
+		|| (length - sizeof(header)) % rowBytes != 0 || header.size != (length - sizeof(header)) / rowBytes)
+		throw SystemError("Load profile file " + path + " has " + std::to_string(header.size)
+			+ " rows, which does not match its size of " + std::to_string(length) + " bytes");
+
+	auto profile = std::shared_ptr<LoadProfile>(new LoadProfile());
+	profile->mType = header.type == static_cast<uint32_t>(Type::PQ) ? Type::PQ : Type::WeightingFactor;
+	profile->mStartTime = header.startTime;
+	profile->mTimeStep = header.timeStep;
+	profile->mSize = static_cast<UInt>(header.size);
+
+	// The header size is a multiple of 8, so the columns are aligned
+	const Real* values = reinterpret_cast<const Real*>(data + sizeof(header));
+	profile->mMapping = mapping;
+	profile->mColumns[0] = values;
+	profile->mColumns[1] = profile->mType == Type::PQ ? values + profile->mSize : nullptr;
+	return profile;
+}
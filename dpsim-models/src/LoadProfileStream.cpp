@@ -0,0 +1,191 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim-models/LoadProfileStream.h>
+#include <dpsim-models/CSVReader.h>
+
+#include <limits>
+
+using namespace CPS;
+
+LoadProfileStream::LoadProfileStream(const String& path, Real startTime, Real timeStep, Real endTime,
+	Bool hhmmss, Bool skipFirstRow, UInt windowSize, Logger::Log log) :
+	mPath(path), mSLog(log), mStartTime(startTime), mTimeStep(timeStep), mEndTime(endTime), mHHMMSS(hhmmss),
+	mWindowSize(std::max<UInt>(windowSize, 4)), mLookBehind(std::max<UInt>(mWindowSize / 4, 1)) {
+
+	if (timeStep <= 0)
+		throw SystemError("Load profile stream requires a positive time step");
+
+	mFile.open(path);
+	if (!mFile)
+		throw SystemError("Cannot open load profile file " + path);
+	mRows = std::make_unique<CSVReaderIterator>(mFile);
+
+	// ignore the first row if it is a title
+	if (skipFirstRow && *mRows != CSVReaderIterator() && !std::isdigit((**mRows).get(0)[0]))
+		mRows->next();
+
+	// The first data row determines the type, assuming time,p,q or time,weighting factor
+	if (*mRows != CSVReaderIterator() && (**mRows).size() == 2)
+		mType = LoadProfile::Type::WeightingFactor;
+	if (!readRow(mPrevRow))
+		throw SystemError("Load profile file " + path + " contains no samples");
+	mEndOfFile = !readRow(mNextRow);
+	if (mStartTime < 0)
+		mStartTime = mPrevRow.time;
+
+	mWindow.assign(2 * mWindowSize, 0);
+	mRunning = true;
+	mThread = std::thread(&LoadProfileStream::readAhead, this);
+}
+
+LoadProfileStream::~LoadProfileStream() {
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mRunning = false;
+	}
+	mSpaceAvailable.notify_one();
+	if (mThread.joinable())
+		mThread.join();
+	if (mSLog && mUnderruns > 0)
+		mSLog->info("Load profile stream {} had {} underruns", mPath, mUnderruns);
+}
+
+Bool LoadProfileStream::readRow(Row& row) {
+	Int columns = mType == LoadProfile::Type::PQ ? 3 : 2;
+	for (; *mRows != CSVReaderIterator(); mRows->next()) {
+		const CSVRow& data = **mRows;
+		if (data.size() < columns)
+			continue;
+
+		row.time = mHHMMSS ? CSVReader::time_format_convert(data.get(0)) : std::stod(data.get(0));
+		if (mType == LoadProfile::Type::PQ) {
+			// multiplied by 1000 due to unit conversion (kw to w)
+			row.values[0] = std::stod(data.get(1)) * 1000;
+			row.values[1] = std::stod(data.get(2)) * 1000;
+		} else {
+			row.values[0] = std::stod(data.get(1));
+			row.values[1] = 0;
+		}
+		mRows->next();
+		return true;
+	}
+	return false;
+}
+
+void LoadProfileStream::readAhead() {
+	try {
+		std::size_t total = mEndTime >= 0
+			? static_cast<std::size_t>(std::floor((mEndTime - mStartTime) / mTimeStep + 1e-9)) + 1
+			: std::numeric_limits<std::size_t>::max();
+
+		for (std::size_t idx = 0; idx < total; ++idx) {
+			// Once the window is full, wait until the samples of a whole look
+			// behind have been released to read on in chunks
+			if (idx >= mReleased.load(std::memory_order_acquire) + mWindowSize) {
+				std::unique_lock<std::mutex> lock(mMutex);
+				mReaderWaiting = true;
+				mSpaceAvailable.wait(lock, [this, idx]() {
+					return !mRunning || idx + mLookBehind <= mReleased + mWindowSize;
+				});
+				mReaderWaiting = false;
+			}
+			if (!mRunning.load(std::memory_order_acquire))
+				break;
+
+			Real x = mStartTime + idx * mTimeStep;
+			while (!mEndOfFile && mNextRow.time <= x) {
+				mPrevRow = mNextRow;
+				mEndOfFile = !readRow(mNextRow);
+			}
+			// Without an end time the profile ends with the last row
+			if (mEndTime < 0 && mEndOfFile && x > mPrevRow.time)
+				break;
+
+			// Linear interpolation, the first and last row are held constant
+			Real delta = (mEndOfFile || x <= mPrevRow.time) ? 0
+				: (x - mPrevRow.time) / (mNextRow.time - mPrevRow.time);
+			std::size_t slot = 2 * (idx % mWindowSize);
+			mWindow[slot] = delta * mNextRow.values[0] + (1 - delta) * mPrevRow.values[0];
+			mWindow[slot + 1] = delta * mNextRow.values[1] + (1 - delta) * mPrevRow.values[1];
+			mProduced.store(idx + 1);
+			if (mSamplerWaiting)
+				notifySampler();
+		}
+	} catch (...) {
+		mError = std::current_exception();
+	}
+	mFinished.store(true);
+	notifySampler();
+}
+
+void LoadProfileStream::notifySampler() {
+	std::lock_guard<std::mutex> lock(mMutex);
+	mSampleAvailable.notify_one();
+}
+
+void LoadProfileStream::waitForSample(std::size_t idx, Real time) {
+	// The reader is usually ahead, so a short spin covers small delays
+	// without a context switch
+	for (UInt spin = 0; spin < SPIN_COUNT; ++spin) {
+		if (idx < mProduced.load(std::memory_order_acquire) || mFinished.load(std::memory_order_acquire))
+			return;
+	}
+
+	// mSamplerWaiting is set before and mProduced stored before checking
+	// the other one, so either the reader notifies or the predicate holds
+	std::unique_lock<std::mutex> lock(mMutex);
+	mSamplerWaiting = true;
+	mSampleAvailable.wait(lock, [this, idx]() {
+		return idx < mProduced || mFinished;
+	});
+	mSamplerWaiting = false;
+	lock.unlock();
+
+	// Powers of two to not flood the log if the reader falls behind for long
+	++mUnderruns;
+	if (mSLog && (mUnderruns & (mUnderruns - 1)) == 0)
+		mSLog->warn("Load profile stream {} underrun at time {}, the reader was behind {} times so far",
+			mPath, time, mUnderruns);
+}
+
+PQData LoadProfileStream::sample(Real time) {
+	Real pos = std::round((time - mStartTime) / mTimeStep);
+	std::size_t idx = pos > 0 ? static_cast<std::size_t>(pos) : 0;
+
+	if (idx >= mProduced.load(std::memory_order_acquire))
+		waitForSample(idx, time);
+	// Otherwise the reader has finished
+	std::size_t produced = mProduced.load(std::memory_order_acquire);
+	if (idx >= produced) {
+		if (mError)
+			std::rethrow_exception(mError);
+		if (produced == 0)
+			throw SystemError("Load profile file " + mPath + " contains no samples");
+		// Times after the end of the profile get its last sample
+		idx = produced - 1;
+	}
+	if (idx < mReleased.load(std::memory_order_acquire))
+		throw SystemError("Load profile stream " + mPath + " cannot go back to time " + std::to_string(time));
+
+	std::size_t slot = 2 * (idx % mWindowSize);
+	PQData data { mWindow[slot], mWindow[slot + 1] };
+
+	// Let the reader overwrite samples behind the look behind
+	if (idx > mLookBehind) {
+		std::size_t released = idx - mLookBehind;
+		std::size_t current = mReleased.load(std::memory_order_relaxed);
+		while (released > current && !mReleased.compare_exchange_weak(current, released))
+			;
+		if (mReaderWaiting && mProduced.load(std::memory_order_acquire) + mLookBehind <= released + mWindowSize) {
+			std::lock_guard<std::mutex> lock(mMutex);
+			mSpaceAvailable.notify_one();
+		}
+	}
+	return data;
+}
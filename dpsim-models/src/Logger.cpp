@@ -6,18 +6,176 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  *********************************************************************************/
 
+#include <atomic>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <experimental/filesystem>
 namespace fs = std::experimental::filesystem;
 
 #include <iomanip>
 
 #include <dpsim-models/Logger.h>
+#include <spdlog/async.h>
+#include <spdlog/details/file_helper.h>
+#include <spdlog/sinks/base_sink.h>
 #include <spdlog/sinks/null_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 
 using namespace CPS;
 
+namespace {
+	/// True if loggers write into the shared log file of their log directory
+	std::atomic<bool> sharedLogFile { false };
+	/// Maximum number of open dedicated log files, zero for no limit
+	std::atomic<UInt> maxLogFiles { 0 };
+	/// Number of open dedicated log files
+	std::atomic<UInt> openLogFiles { 0 };
+
+	/// Log file that all loggers of a log directory without a dedicated file
+	/// write into. Each line is prefixed with the name of the logger.
+	class SharedLogFile {
+	public:
+		using Ptr = std::shared_ptr<SharedLogFile>;
+
+		explicit SharedLogFile(const String& filename) : mFilename(filename) { }
+
+		/// Shared log file of the given log directory, kept open until exit
+		static Ptr get(const String& logDir) {
+			static std::mutex mutex;
+			static std::map<String, Ptr> files;
+			std::lock_guard<std::mutex> lock(mutex);
+			auto& file = files[logDir];
+			if (!file)
+				file = std::make_shared<SharedLogFile>(logDir + "/dpsim.log");
+			return file;
+		}
+
+		void write(const spdlog::string_view_t& name, const spdlog::memory_buf_t& formatted) {
+			std::lock_guard<std::mutex> lock(mMutex);
+			if (!mOpen) {
+				mFile.open(mFilename, true);
+				mOpen = true;
+			}
+			mLine.clear();
+			mLine.push_back('[');
+			mLine.append(name.data(), name.data() + name.size());
+			const char separator[] = "] ";
+			mLine.append(separator, separator + 2);
+			mLine.append(formatted.data(), formatted.data() + formatted.size());
+			mFile.write(mLine);
+		}
+
+		void flush() {
+			std::lock_guard<std::mutex> lock(mMutex);
+			if (mOpen)
+				mFile.flush();
+		}
+
+	private:
+		String mFilename;
+		std::mutex mMutex;
+		spdlog::details::file_helper mFile;
+		Bool mOpen = false;
+		spdlog::memory_buf_t mLine;
+	};
+
+	/// Sink of one logger into the shared log file
+	class SharedFileSink : public spdlog::sinks::base_sink<std::mutex> {
+	public:
+		explicit SharedFileSink(SharedLogFile::Ptr file) : mFile(file) { }
+
+	protected:
+		void sink_it_(const spdlog::details::log_msg& msg) override {
+			spdlog::memory_buf_t formatted;
+			formatter_->format(msg, formatted);
+			mFile->write(msg.logger_name, formatted);
+		}
+		void flush_() override { mFile->flush(); }
+
+	private:
+		SharedLogFile::Ptr mFile;
+	};
+
+	/// File sink that only opens its file when the first message is written.
+	/// Once the limit of open log files is reached, further sinks write into
+	/// the shared log file instead.
+	class LazyFileSink : public spdlog::sinks::base_sink<std::mutex> {
+	public:
+		LazyFileSink(const String& filename, const String& logDir, Bool limited) :
+			mFilename(filename), mLogDir(logDir), mLimited(limited) { }
+
+		~LazyFileSink() {
+			if (mOpen)
+				--openLogFiles;
+		}
+
+	protected:
+		void sink_it_(const spdlog::details::log_msg& msg) override {
+			if (!mOpen && !mShared)
+				open();
+
+			spdlog::memory_buf_t formatted;
+			formatter_->format(msg, formatted);
+			if (mShared)
+				mShared->write(msg.logger_name, formatted);
+			else
+				mFile.write(formatted);
+		}
+
+		void flush_() override {
+			if (mShared)
+				mShared->flush();
+			else if (mOpen)
+				mFile.flush();
+		}
+
+	private:
+		void open() {
+			UInt limit = maxLogFiles;
+			if (mLimited && limit > 0 && openLogFiles.fetch_add(1) >= limit) {
+				--openLogFiles;
+				mShared = SharedLogFile::get(mLogDir);
+				return;
+			}
+			if (!mLimited || limit == 0)
+				++openLogFiles;
+			mOpen = true;
+			mFile.open(mFilename, true);
+		}
+
+		String mFilename;
+		String mLogDir;
+		Bool mLimited;
+		Bool mOpen = false;
+		spdlog::details::file_helper mFile;
+		SharedLogFile::Ptr mShared;
+	};
+
+	/// Thread writing the messages of all loggers of the shared log file
+	std::shared_ptr<spdlog::details::thread_pool> sharedLogThread() {
+		static std::mutex mutex;
+		static std::shared_ptr<spdlog::details::thread_pool> pool;
+		std::lock_guard<std::mutex> lock(mutex);
+		if (!pool)
+			pool = std::make_shared<spdlog::details::thread_pool>(8192, 1);
+		return pool;
+	}
+
+	/// Creates the log directory once instead of checking it for every logger
+	void createLogDir(const String& logDir) {
+		static std::mutex mutex;
+		static std::set<String> created;
+		std::lock_guard<std::mutex> lock(mutex);
+		if (!created.insert(logDir).second)
+			return;
+		fs::path p = logDir;
+		if (!p.empty() && !fs::exists(p))
+			fs::create_directories(p);
+	}
+}
+
 
 void Logger::setLogLevel(std::shared_ptr<spdlog::logger> logger, Logger::Level level) {
 	logger->set_level(level);
@@ -94,6 +252,14 @@ void Logger::setLogDir(String path) {
 #endif
 }
 
+void Logger::setSharedLogFile(Bool shared) {
+	sharedLogFile = shared;
+}
+
+void Logger::setMaxLogFiles(UInt count) {
+	maxLogFiles = count;
+}
+
 String Logger::getCSVColumnNames(std::vector<String> names) {
 	std::stringstream ss;
     ss << std::right << std::setw(14) << "time";
@@ -146,16 +312,21 @@ Logger::Log Logger::get(const std::string &name, Level filelevel, Level clilevel
 	return logger;
 }
 
-Logger::Log Logger::create(const std::string &name, Level filelevel, Level clilevel) {
+Logger::Log Logger::getDedicated(const std::string &name, Level filelevel) {
+	return create(name, filelevel, Level::off, true);
+}
+
+Logger::Log Logger::create(const std::string &name, Level filelevel, Level clilevel, Bool dedicated) {
 	String logDir = Logger::logDir();
 	String filename = logDir + "/" + name + ".log";
 	std::vector<spdlog::sink_ptr> sinks;
 	Logger::Log ret;
+	Bool shared = sharedLogFile && !dedicated;
 
 	// Create log folder if it does not exist
 	fs::path p = filename;
-	if (p.has_parent_path() && !fs::exists(p.parent_path()))
-		fs::create_directories(p.parent_path());
+	if (p.has_parent_path())
+		createLogDir(p.parent_path().string());
 
 	if (clilevel != Logger::Level::off) {
 		auto console_sink = std::make_shared<spdlog::sinks::stderr_color_sink_mt>();
@@ -164,8 +335,13 @@ Logger::Log Logger::create(const std::string &name, Level filelevel, Level clile
 		sinks.push_back(console_sink);
 	}
 
+	// Files are only opened when the first message is logged
 	if (filelevel != Logger::Level::off) {
-		auto file_sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(filename, true);
+		spdlog::sink_ptr file_sink;
+		if (shared)
+			file_sink = std::make_shared<SharedFileSink>(SharedLogFile::get(logDir));
+		else
+			file_sink = std::make_shared<LazyFileSink>(filename, logDir, !dedicated);
 		file_sink->set_level(filelevel);
 		file_sink->set_pattern(prefix() + "[%L] %v");
 		sinks.push_back(file_sink);
@@ -173,6 +349,8 @@ Logger::Log Logger::create(const std::string &name, Level filelevel, Level clile
 
 	if (filelevel == Logger::Level::off && clilevel == Logger::Level::off) {
 		ret = spdlog::create<spdlog::sinks::null_sink_st>(name);
+	} else if (shared) {
+		ret = std::make_shared<spdlog::async_logger>(name, begin(sinks), end(sinks), sharedLogThread());
 	} else {
 		ret = std::make_shared<spdlog::logger>(name, begin(sinks), end(sinks));
 	}
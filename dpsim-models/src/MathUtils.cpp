@@ -160,6 +160,63 @@ void Math::addToMatrixElement(Matrix& mat, std::vector<UInt> rows, std::vector<U
 		addToMatrixElement(mat, rows[phase], columns[phase], value);
 }
 
+void Math::setMatrixElement(SparseMatrixRow& mat, Matrix::Index row, Matrix::Index column, Complex value, Int maxFreq, Int freqIdx) {
+	// Assume square matrix
+	Eigen::Index harmonicOffset = mat.rows() / maxFreq;
+	Eigen::Index complexOffset = harmonicOffset / 2;
+	Eigen::Index harmRow = row + harmonicOffset * freqIdx;
+	Eigen::Index harmCol = column + harmonicOffset * freqIdx;
+
+	mat.coeffRef(harmRow, harmCol) = value.real();
+	mat.coeffRef(harmRow + complexOffset, harmCol + complexOffset) = value.real();
+	mat.coeffRef(harmRow, harmCol + complexOffset) = - value.imag();
+	mat.coeffRef(harmRow + complexOffset, harmCol) = value.imag();
+}
+
+void Math::addToMatrixElement(SparseMatrixRow& mat, Matrix::Index row, Matrix::Index column, Complex value, Int maxFreq, Int freqIdx) {
+	// Assume square matrix
+	Eigen::Index harmonicOffset = mat.rows() / maxFreq;
+	Eigen::Index complexOffset = harmonicOffset / 2;
+	Eigen::Index harmRow = row + harmonicOffset * freqIdx;
+	Eigen::Index harmCol = column + harmonicOffset * freqIdx;
+
+	mat.coeffRef(harmRow, harmCol) += value.real();
+	mat.coeffRef(harmRow + complexOffset, harmCol + complexOffset) += value.real();
+	mat.coeffRef(harmRow, harmCol + complexOffset) -= value.imag();
+	mat.coeffRef(harmRow + complexOffset, harmCol) += value.imag();
+}
+
+void Math::addToMatrixElement(SparseMatrixRow& mat, Matrix::Index row, Matrix::Index column, Matrix value, Int maxFreq, Int freqIdx) {
+	// Assume square matrix
+	Eigen::Index harmonicOffset = mat.rows() / maxFreq;
+	Eigen::Index complexOffset = harmonicOffset / 2;
+	Eigen::Index harmRow = row + harmonicOffset * freqIdx;
+	Eigen::Index harmCol = column + harmonicOffset * freqIdx;
+
+	mat.coeffRef(harmRow, harmCol) += value(0,0);
+	mat.coeffRef(harmRow + complexOffset, harmCol + complexOffset) += value(1,1);
+	mat.coeffRef(harmRow, harmCol + complexOffset) += value(0,1);
+	mat.coeffRef(harmRow + complexOffset, harmCol) += value(1,0);
+}
+
+void Math::setMatrixElement(SparseMatrixRow& mat, Matrix::Index row, Matrix::Index column, Real value) {
+	mat.coeffRef(row, column) = value;
+}
+
+void Math::addToMatrixElement(SparseMatrixRow& mat, std::vector<UInt> rows, std::vector<UInt> columns, Complex value) {
+	for (UInt phase = 0; phase < rows.size(); phase++)
+		addToMatrixElement(mat, rows[phase], columns[phase], value);
+}
+
+void Math::addToMatrixElement(SparseMatrixRow& mat, Matrix::Index row, Matrix::Index column, Real value) {
+	mat.coeffRef(row, column) += value;
+}
+
+void Math::addToMatrixElement(SparseMatrixRow& mat, std::vector<UInt> rows, std::vector<UInt> columns, Real value) {
+	for (UInt phase = 0; phase < rows.size(); phase++)
+		addToMatrixElement(mat, rows[phase], columns[phase], value);
+}
+
 MatrixComp Math::singlePhaseVariableToThreePhase(Complex var_1ph) {
 	MatrixComp var_3ph = MatrixComp::Zero(3, 1);
 	var_3ph <<
@@ -33,6 +33,8 @@ void SP::Ph1::Load::setParameters(Real activePower, Real reactivePower, Real nom
 	**mActivePower = activePower;
 	**mReactivePower = reactivePower;
 	**mNomVoltage = nominalVoltage;
+	mNomActivePower = activePower;
+	mNomReactivePower = reactivePower;
 
 	mSLog->info("Active Power={} [W] Reactive Power={} [VAr]", **mActivePower, **mReactivePower);
 	mSLog->flush();
@@ -83,16 +85,28 @@ void SP::Ph1::Load::modifyPowerFlowBusType(PowerflowBusType powerflowBusType) {
 
 
 void SP::Ph1::Load::updatePQ(Real time) {
-	if (mLoadProfile.weightingFactors.empty()) {
-		**mActivePower = mLoadProfile.pqData.find(time)->second.p;
-		**mReactivePower = mLoadProfile.pqData.find(time)->second.q;
+	if (mLoadProfileStream) {
+		PQData data = mLoadProfileStream->sample(time);
+		if (mLoadProfileStream->type() == LoadProfile::Type::PQ) {
+			**mActivePower = data.p;
+			**mReactivePower = data.q;
+		} else {
+			**mActivePower = mNomActivePower * data.p;
+			**mReactivePower = mNomReactivePower * data.p;
+		}
+		return;
+	}
+	if (!mLoadProfile)
+		return;
+
+	UInt idx = mLoadProfile->index(time);
+	if (mLoadProfile->type() == LoadProfile::Type::PQ) {
+		**mActivePower = mLoadProfile->activePower(idx);
+		**mReactivePower = mLoadProfile->reactivePower(idx);
 	} else {
-		Real wf = mLoadProfile.weightingFactors.find(time)->second;
-		///THISISBAD: P_nom and Q_nom do not exist as attributes
-		Real P_new = this->attributeTyped<Real>("P_nom")->get()*wf;
-		Real Q_new = this->attributeTyped<Real>("Q_nom")->get()*wf;
-		**mActivePower = P_new;
-		**mReactivePower = Q_new;
+		Real wf = mLoadProfile->weightingFactor(idx);
+		**mActivePower = mNomActivePower * wf;
+		**mReactivePower = mNomReactivePower * wf;
 	}
 };
 
@@ -60,9 +60,10 @@ void SP::Ph1::SynchronGenerator4OrderDCIM::calculateStateMatrix() {
 			0.0, 								(1. / Td_t) * (mLd-mLd_t) / mLd;
 	mC <<	0,
 	   		(1. / Td_t) * **mEf * (mLd_t / mLd);
+	mStateSpace.setParameters(mA, mB, mC, mTimeStep);
 }
 
-void SP::Ph1::SynchronGenerator4OrderDCIM::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void SP::Ph1::SynchronGenerator4OrderDCIM::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 }
 
 void SP::Ph1::SynchronGenerator4OrderDCIM::stepInPerUnit() {
@@ -71,7 +72,7 @@ void SP::Ph1::SynchronGenerator4OrderDCIM::stepInPerUnit() {
 	mComplexAToDq = mDqToComplexA.transpose();
 
 	// calculate Edq at t=k+1. Assumption: Vdq(k) = Vdq(k+1)
-	(**mEdq_t) = Math::StateSpaceTrapezoidal(**mEdq_t, mA, mB, mC, mTimeStep, **mVdq);
+	(**mEdq_t) = mStateSpace.step(**mEdq_t, **mVdq);
 
 	// armature currents for at t=k+1
 	(**mIdq)(0,0) = ((**mEdq_t)(1,0) - (**mVdq)(1,0) ) / mLd_t;
@@ -51,7 +51,7 @@ void SP::Ph3::Resistor::mnaInitialize(Real omega, Real timeStep, Attribute<Matri
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
 }
 
-void SP::Ph3::Resistor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void SP::Ph3::Resistor::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 
 	Matrix conductance = (**mResistance).inverse();
 
@@ -36,6 +36,13 @@ void PLL::setParameters(Real kpPLL, Real kiPLL, Real omegaNom) {
 void PLL::setSimulationParameters(Real timestep) {
     mTimeStep = timestep;
     mSLog->info("Integration step = {}", mTimeStep);
+
+    discretize();
+}
+
+void PLL::discretize() {
+    if (mComposed && mTimeStep > 0)
+        mStateSpace.setParameters(mA, mB, mTimeStep);
 }
 
 void PLL::setInitialValues(Real input_init, Matrix state_init, Matrix output_init) {
@@ -62,6 +69,9 @@ void PLL::composeStateSpaceMatrices() {
     mSLog->info("B = \n{}", mB);
     mSLog->info("C = \n{}", mC);
     mSLog->info("D = \n{}", mD);
+
+    mComposed = true;
+    discretize();
 }
 
 void PLL::signalAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) {
@@ -84,12 +94,15 @@ void PLL::signalAddStepDependencies(AttributeBase::List &prevStepDependencies, A
 };
 
 void PLL::signalStep(Real time, Int timeStepCount) {
+    if (!mComposed || mTimeStep <= 0)
+        throw SystemError("PLL " + **mName + " is stepped before its state space model is composed and discretized");
+
     (**mInputCurr)(1,0) = **mInputRef;
 
     mSLog->info("Time {}:", time);
     mSLog->info("Input values: inputCurr = ({}, {}), inputPrev = ({}, {}), stateCurr = ({}, {}), statePrev = ({}, {})", (**mInputCurr)(0,0), (**mInputCurr)(1,0), (**mInputPrev)(0,0), (**mInputPrev)(1,0), (**mStateCurr)(0,0), (**mStateCurr)(1,0), (**mStatePrev)(0,0), (**mStatePrev)(1,0));
 
-    **mStateCurr = Math::StateSpaceTrapezoidal(**mStatePrev, mA, mB, mTimeStep, **mInputCurr, **mInputPrev);
+    **mStateCurr = mStateSpace.step(**mStatePrev, **mInputCurr, **mInputPrev);
     **mOutputCurr = mC * **mStateCurr + mD * **mInputCurr;
 
     mSLog->info("State values: stateCurr = ({}, {})", (**mStateCurr)(0,0), (**mStateCurr)(1,0));
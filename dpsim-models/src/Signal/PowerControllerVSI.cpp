@@ -112,6 +112,7 @@ void PowerControllerVSI::initializeStateSpaceModel(Real omega, Real timeStep, At
 
 	// update B matrix due to its dependence on Irc
 	updateBMatrixStateSpaceModel();
+	mStateSpace.setParameters(mA, mB, mTimeStep);
 
 	// initialization of input
 	**mInputCurr << mPref, mQref, **mVc_d, **mVc_q, **mIrc_d, **mIrc_q;
@@ -149,15 +150,16 @@ void PowerControllerVSI::signalAddStepDependencies(AttributeBase::List &prevStep
 };
 
 void PowerControllerVSI::signalStep(Real time, Int timeStepCount) {
-	// update B matrix due to its dependence on Irc
+	// update B matrix due to its dependence on Irc, A remains constant
 	updateBMatrixStateSpaceModel();
+	mStateSpace.setInputMatrix(mB);
 
 	// get current inputs
 	**mInputCurr << mPref, mQref, **mVc_d, **mVc_q, **mIrc_d, **mIrc_q;
     mSLog->debug("Time {}\n: inputCurr = \n{}\n , inputPrev = \n{}\n , statePrev = \n{}", time, **mInputCurr, **mInputPrev, **mStatePrev);
 
 	// calculate new states
-	**mStateCurr = Math::StateSpaceTrapezoidal(**mStatePrev, mA, mB, mTimeStep, **mInputCurr, **mInputPrev);
+	**mStateCurr = mStateSpace.step(**mStatePrev, **mInputCurr, **mInputPrev);
 	mSLog->debug("stateCurr = \n {}", **mStateCurr);
 
 	// calculate new outputs
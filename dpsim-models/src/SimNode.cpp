@@ -127,6 +127,13 @@ void SimNode<Complex>::mnaUpdateVoltage(const Matrix& leftVector) {
 	}
 }
 
+template <typename VarType>
+void SimNode<VarType>::mnaInitialize(Attribute<Matrix>::Ptr leftVector) {
+	mMnaTasks = {
+		std::make_shared<MnaPostStep>(*this, leftVector)
+	};
+}
+
 template<>
 void SimNode<Real>::mnaUpdateVoltageHarm(const Matrix& leftVector, Int freqIdx) { }
 
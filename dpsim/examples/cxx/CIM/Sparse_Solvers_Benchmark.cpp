@@ -0,0 +1,184 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+// Compares the step times of the EigenSparse and LeftLookingSparse MNA solvers
+// on the coupled WSCC_9bus_mult system and on the CIGRE MV grid with a load
+// step, with precomputed switch matrices and with system matrix recomputation.
+// Options: copies (default 10), duration (default 0.1)
+
+#include <iostream>
+#include <list>
+
+#include <DPsim.h>
+#include "../Examples.h"
+
+using namespace DPsim;
+using namespace CPS;
+using namespace CPS::CIM;
+
+void multiply_connected(SystemTopology& sys, int copies,
+	Real resistance, Real inductance, Real capacitance) {
+
+	sys.multiply(copies);
+	int counter = 0;
+	std::vector<String> nodes = {"BUS5", "BUS8", "BUS6"};
+
+	for (auto orig_node : nodes) {
+		std::vector<String> nodeNames{orig_node};
+		for (int i = 2; i < copies+2; i++) {
+			nodeNames.push_back(orig_node + "_" + std::to_string(i));
+		}
+		nodeNames.push_back(orig_node);
+
+		int nlines = copies == 1 ? 1 : copies+1;
+		for (int i = 0; i < nlines; i++) {
+			auto rl_node = std::make_shared<DP::SimNode>("N_add_" + std::to_string(counter));
+			auto res = DP::Ph1::Resistor::make("R_" + std::to_string(counter));
+			res->setParameters(resistance);
+			auto ind = DP::Ph1::Inductor::make("L_" + std::to_string(counter));
+			ind->setParameters(inductance);
+			auto cap1 = DP::Ph1::Capacitor::make("C1_" + std::to_string(counter));
+			cap1->setParameters(capacitance / 2.);
+			auto cap2 = DP::Ph1::Capacitor::make("C2_" + std::to_string(counter));
+			cap2->setParameters(capacitance / 2.);
+
+			sys.addNode(rl_node);
+			res->connect({sys.node<DP::SimNode>(nodeNames[i]), rl_node});
+			ind->connect({rl_node, sys.node<DP::SimNode>(nodeNames[i+1])});
+			cap1->connect({sys.node<DP::SimNode>(nodeNames[i]), DP::SimNode::GND});
+			cap2->connect({sys.node<DP::SimNode>(nodeNames[i+1]), DP::SimNode::GND});
+			counter += 1;
+
+			sys.addComponent(res);
+			sys.addComponent(ind);
+			sys.addComponent(cap1);
+			sys.addComponent(cap2);
+		}
+	}
+}
+
+String solverName(MnaSolverFactory::MnaSolverImpl impl) {
+	return impl == MnaSolverFactory::LeftLookingSparse ? "LeftLookingSparse" : "EigenSparse";
+}
+
+void printStatistics(const String& grid, MnaSolverFactory::MnaSolverImpl impl, Bool recomputation, Simulation& sim) {
+	auto& stats = sim.stepTimeStatistics();
+	std::cout << grid << "," << solverName(impl) << "," << recomputation << ","
+		<< stats.mean().count() << ","
+		<< stats.quantile(0.5).count() << ","
+		<< stats.quantile(0.99).count() << ","
+		<< stats.max().count() << std::endl;
+}
+
+void simulateWSCC(std::list<fs::path> filenames, MnaSolverFactory::MnaSolverImpl impl, Int copies, Real duration) {
+	String simName = "Sparse_Solvers_WSCC_" + solverName(impl) + "_" + std::to_string(copies);
+	Logger::setLogDir("logs/"+simName);
+
+	CIM::Reader reader(simName, Logger::Level::off, Logger::Level::off);
+	SystemTopology sys = reader.loadCIM(60, filenames, Domain::DP, PhaseType::Single, CPS::GeneratorType::IdealVoltageSource);
+	if (copies > 0)
+		multiply_connected(sys, copies, 12.5, 0.16, 1e-6);
+
+	Simulation sim(simName, Logger::Level::off);
+	sim.setSystem(sys);
+	sim.setTimeStep(0.0001);
+	sim.setFinalTime(duration);
+	sim.setDomain(Domain::DP);
+	sim.setMnaSolverImplementation(impl);
+	sim.doStepTimeRecording(false);
+	sim.run();
+
+	printStatistics("wscc", impl, false, sim);
+}
+
+void simulateCIGRE(std::list<fs::path> filenames, const SystemTopology& systemPF,
+	MnaSolverFactory::MnaSolverImpl impl, Bool recomputation, Real duration) {
+
+	Examples::Grids::CIGREMV::ScenarioConfig scenario;
+	String simName = "Sparse_Solvers_CIGRE_" + solverName(impl) + (recomputation ? "_recomp" : "");
+	Logger::setLogDir("logs/" + simName);
+
+	CIM::Reader reader(simName, Logger::Level::off, Logger::Level::off);
+	SystemTopology systemDP = reader.loadCIM(scenario.systemFrequency, filenames, CPS::Domain::DP);
+	Examples::Grids::CIGREMV::addInvertersToCIGREMV(systemDP, scenario, Domain::DP);
+	systemDP.initWithPowerflow(systemPF);
+
+	// The load step switches in the middle of the simulation
+	auto logger = DataLogger::make(simName);
+	auto loadStepEvent = Examples::Events::createEventAddPowerConsumption("N11", duration / 2, 1500.0e3, systemDP, Domain::DP, logger);
+
+	Simulation sim(simName, Logger::Level::off);
+	sim.setSystem(systemDP);
+	sim.setTimeStep(0.1e-3);
+	sim.setFinalTime(duration);
+	sim.setDomain(Domain::DP);
+	sim.setMnaSolverImplementation(impl);
+	sim.doSystemMatrixRecomputation(recomputation);
+	sim.doInitFromNodesAndTerminals(true);
+	sim.doSteadyStateInit(false);
+	sim.doStepTimeRecording(false);
+	sim.addEvent(loadStepEvent);
+	sim.run();
+
+	printStatistics("cigre", impl, recomputation, sim);
+}
+
+int main(int argc, char *argv[]) {
+	CommandLineArgs args(argc, argv);
+
+	Int numCopies = 10;
+	Real duration = 0.1;
+	if (args.options.find("copies") != args.options.end())
+		numCopies = args.getOptionInt("copies");
+	if (args.options.find("duration") != args.options.end())
+		duration = args.getOptionReal("duration");
+
+	std::list<fs::path> filenamesWSCC = DPsim::Utils::findFiles({
+		"WSCC-09_RX_DI.xml",
+		"WSCC-09_RX_EQ.xml",
+		"WSCC-09_RX_SV.xml",
+		"WSCC-09_RX_TP.xml"
+	}, "build/_deps/cim-data-src/WSCC-09/WSCC-09_RX", "CIMPATH");
+
+	std::list<fs::path> filenamesCIGRE = DPsim::Utils::findFiles({
+		"Rootnet_FULL_NE_28J17h_DI.xml",
+		"Rootnet_FULL_NE_28J17h_EQ.xml",
+		"Rootnet_FULL_NE_28J17h_SV.xml",
+		"Rootnet_FULL_NE_28J17h_TP.xml"
+	}, "dpsim/Examples/CIM/grid-data/CIGRE_MV/NEPLAN/CIGRE_MV_no_tapchanger_noLoad1_LeftFeeder_With_LoadFlow_Results", "CIMPATH");
+
+	// Powerflow for the initialization of the CIGRE grid
+	Examples::Grids::CIGREMV::ScenarioConfig scenario;
+	String simNamePF = "Sparse_Solvers_CIGRE_Powerflow";
+	Logger::setLogDir("logs/" + simNamePF);
+	CIM::Reader reader(simNamePF, Logger::Level::off, Logger::Level::off);
+	SystemTopology systemPF = reader.loadCIM(scenario.systemFrequency, filenamesCIGRE, Domain::SP);
+	Examples::Grids::CIGREMV::addInvertersToCIGREMV(systemPF, scenario, Domain::SP);
+
+	Simulation simPF(simNamePF, Logger::Level::off);
+	simPF.setSystem(systemPF);
+	simPF.setTimeStep(1);
+	simPF.setFinalTime(2);
+	simPF.setDomain(Domain::SP);
+	simPF.setSolverType(Solver::Type::NRP);
+	simPF.setSolverAndComponentBehaviour(Solver::Behaviour::Initialization);
+	simPF.doInitFromNodesAndTerminals(true);
+	simPF.run();
+
+	std::vector<MnaSolverFactory::MnaSolverImpl> solvers = {
+		MnaSolverFactory::EigenSparse, MnaSolverFactory::LeftLookingSparse
+	};
+
+	// Step times in nanoseconds
+	std::cout << "grid,solver,recomputation,mean,p50,p99,max" << std::endl;
+	for (auto impl : solvers) {
+		simulateWSCC(filenamesWSCC, impl, numCopies, duration);
+		simulateCIGRE(filenamesCIGRE, systemPF, impl, false, duration);
+		simulateCIGRE(filenamesCIGRE, systemPF, impl, true, duration);
+	}
+}
@@ -96,6 +96,7 @@ void simulateCoupled(std::list<fs::path> filenames, CommandLineArgs& args, Int c
 	//}
 	//sim.addLogger(logger);
 
+	sim.doStepTimeRecording(true);
 	sim.run();
 	sim.logStepTimes(simName + "_step_times");
 }
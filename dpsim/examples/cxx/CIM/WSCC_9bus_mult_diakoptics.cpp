@@ -17,7 +17,7 @@ using namespace DPsim;
 using namespace CPS;
 
 IdentifiedObject::List multiply_diakoptics(SystemTopology& sys, Int copies,
-	Real resistance, Real inductance, Real capacitance, Int splits = 0) {
+	Real resistance, Real inductance, Real capacitance, Int splits = 0, Bool tear = true) {
 
     sys.multiply(copies);
 	int counter = 0;
@@ -45,7 +45,7 @@ IdentifiedObject::List multiply_diakoptics(SystemTopology& sys, Int copies,
             line->setParameters(resistance, inductance, capacitance);
             line->connect({sys.node<DP::SimNode>(nodeNames[i]), sys.node<DP::SimNode>(nodeNames[i+1])});
 
-			if (i % splitEvery == 0) {
+			if (tear && i % splitEvery == 0) {
                 sys.addTearComponent(line);
 				//std::cout 	<< "add tear line between node " << sys.node<DP::SimNode>(nodeNames[i])->name()
 				//			<< " and node " << sys.node<DP::SimNode>(nodeNames[i+1])->name() << std::endl;
@@ -60,7 +60,7 @@ IdentifiedObject::List multiply_diakoptics(SystemTopology& sys, Int copies,
 }
 
 void simulateDiakoptics(std::list<fs::path> filenames,
-	Int copies, Int threads, UInt splits = 0, Int seq = 0) {
+	Int copies, Int threads, UInt splits = 0, Int seq = 0, Int autoSplits = 0) {
 
 	String simName = "WSCC_9bus_diakoptics_" + std::to_string(copies)
 		+ "_" + std::to_string(threads) + "_" + std::to_string(splits)
@@ -71,7 +71,7 @@ void simulateDiakoptics(std::list<fs::path> filenames,
 	SystemTopology sys = reader.loadCIM(60, filenames, Domain::DP, PhaseType::Single, CPS::GeneratorType::IdealVoltageSource);
 
 	if (copies > 0)
-		IdentifiedObject::List tearComps = multiply_diakoptics(sys, copies, 12.5, 0.16, 1e-6, splits);
+		IdentifiedObject::List tearComps = multiply_diakoptics(sys, copies, 12.5, 0.16, 1e-6, splits, autoSplits < 2);
 
 	Simulation sim(simName, Logger::Level::off);
 	sim.setSystem(sys);
@@ -80,7 +80,9 @@ void simulateDiakoptics(std::list<fs::path> filenames,
 	sim.setDomain(Domain::DP);
 	if (threads > 0)
 		sim.setScheduler(std::make_shared<OpenMPLevelScheduler>(threads));
-	if (copies > 0)
+	if (autoSplits > 1)
+		sim.setAutomaticTearing(autoSplits, threads > 0 ? threads : 1);
+	else if (copies > 0)
 		sim.setTearingComponents(sys.mTearComponents);
 
 	// Logging
@@ -98,6 +100,7 @@ void simulateDiakoptics(std::list<fs::path> filenames,
 	//}
 	//sim.addLogger(logger);
 
+	sim.doStepTimeRecording(true);
 	sim.run();
 	sim.logStepTimes(simName + "_step_times");
 }
@@ -125,6 +128,7 @@ int main(int argc, char *argv[]) {
 	Int numThreads = 0;
 	Int numSeq = 0;
 	Int numSplits = 0;
+	Int numAutoSplits = 0;
 
 	if (args.options.find("copies") != args.options.end())
 		numCopies = args.getOptionInt("copies");
@@ -134,10 +138,13 @@ int main(int argc, char *argv[]) {
 		numSeq = args.getOptionInt("seq");
 	if (args.options.find("splits") != args.options.end())
 		numSplits = args.getOptionInt("splits");
+	// Let the partitioner select the tear lines for the given number of subnets
+	if (args.options.find("autoSplits") != args.options.end())
+		numAutoSplits = args.getOptionInt("autoSplits");
 
 	std::cout << "Simulate with " << numCopies << " copies, "
 		<< numThreads << " threads, "
 		<< numSplits << " splits, sequence number "
 		<< numSeq << std::endl;
-	simulateDiakoptics(filenames, numCopies, numThreads, numSplits, numSeq);
+	simulateDiakoptics(filenames, numCopies, numThreads, numSplits, numSeq, numAutoSplits);
 }
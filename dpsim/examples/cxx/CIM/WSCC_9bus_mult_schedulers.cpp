@@ -0,0 +1,146 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+// Compares the step times of the parallel schedulers on the coupled
+// WSCC_9bus_mult system for 1 to maxThreads threads.
+// Options: copies (default 10), maxThreads (default 32), duration (default 0.1)
+
+#include <iostream>
+#include <list>
+
+#include <DPsim.h>
+#include <dpsim/ThreadLevelScheduler.h>
+#include <dpsim/ThreadListScheduler.h>
+#include <dpsim/WorkStealingScheduler.h>
+
+using namespace DPsim;
+using namespace CPS;
+
+void multiply_connected(SystemTopology& sys, int copies,
+	Real resistance, Real inductance, Real capacitance) {
+
+	sys.multiply(copies);
+	int counter = 0;
+	std::vector<String> nodes = {"BUS5", "BUS8", "BUS6"};
+
+	for (auto orig_node : nodes) {
+		std::vector<String> nodeNames{orig_node};
+		for (int i = 2; i < copies+2; i++) {
+			nodeNames.push_back(orig_node + "_" + std::to_string(i));
+		}
+		nodeNames.push_back(orig_node);
+
+		int nlines = copies == 1 ? 1 : copies+1;
+		for (int i = 0; i < nlines; i++) {
+			auto rl_node = std::make_shared<DP::SimNode>("N_add_" + std::to_string(counter));
+			auto res = DP::Ph1::Resistor::make("R_" + std::to_string(counter));
+			res->setParameters(resistance);
+			auto ind = DP::Ph1::Inductor::make("L_" + std::to_string(counter));
+			ind->setParameters(inductance);
+			auto cap1 = DP::Ph1::Capacitor::make("C1_" + std::to_string(counter));
+			cap1->setParameters(capacitance / 2.);
+			auto cap2 = DP::Ph1::Capacitor::make("C2_" + std::to_string(counter));
+			cap2->setParameters(capacitance / 2.);
+
+			sys.addNode(rl_node);
+			res->connect({sys.node<DP::SimNode>(nodeNames[i]), rl_node});
+			ind->connect({rl_node, sys.node<DP::SimNode>(nodeNames[i+1])});
+			cap1->connect({sys.node<DP::SimNode>(nodeNames[i]), DP::SimNode::GND});
+			cap2->connect({sys.node<DP::SimNode>(nodeNames[i+1]), DP::SimNode::GND});
+			counter += 1;
+
+			sys.addComponent(res);
+			sys.addComponent(ind);
+			sys.addComponent(cap1);
+			sys.addComponent(cap2);
+		}
+	}
+}
+
+std::shared_ptr<Scheduler> createScheduler(const String& name, Int threads) {
+	if (name == "thread_level")
+		return std::make_shared<ThreadLevelScheduler>(threads);
+	if (name == "thread_list")
+		return std::make_shared<ThreadListScheduler>(threads);
+	if (name == "work_stealing")
+		return std::make_shared<WorkStealingScheduler>(threads);
+#ifdef WITH_OPENMP
+	if (name == "openmp_level")
+		return std::make_shared<OpenMPLevelScheduler>(threads);
+#endif
+	return nullptr;
+}
+
+void simulate(std::list<fs::path> filenames, const String& scheduler, Int copies, Int threads, Real duration) {
+	String simName = "WSCC_9bus_schedulers_" + scheduler + "_" + std::to_string(copies)
+		+ "_" + std::to_string(threads);
+	Logger::setLogDir("logs/"+simName);
+
+	CIM::Reader reader(simName, Logger::Level::off, Logger::Level::off);
+	SystemTopology sys = reader.loadCIM(60, filenames, Domain::DP, PhaseType::Single, CPS::GeneratorType::IdealVoltageSource);
+
+	if (copies > 0)
+		multiply_connected(sys, copies, 12.5, 0.16, 1e-6);
+
+	Simulation sim(simName, Logger::Level::off);
+	sim.setSystem(sys);
+	sim.setTimeStep(0.0001);
+	sim.setFinalTime(duration);
+	sim.setDomain(Domain::DP);
+	sim.doSplitSubnets(true);
+	sim.doStepTimeRecording(false);
+	if (auto sched = createScheduler(scheduler, threads))
+		sim.setScheduler(sched);
+
+	sim.run();
+
+	auto& stats = sim.stepTimeStatistics();
+	std::cout << scheduler << "," << threads << ","
+		<< stats.mean().count() << ","
+		<< stats.quantile(0.5).count() << ","
+		<< stats.quantile(0.99).count() << ","
+		<< stats.max().count() << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+	CommandLineArgs args(argc, argv);
+
+	std::list<fs::path> filenames;
+	filenames = DPsim::Utils::findFiles({
+		"WSCC-09_RX_DI.xml",
+		"WSCC-09_RX_EQ.xml",
+		"WSCC-09_RX_SV.xml",
+		"WSCC-09_RX_TP.xml"
+	}, "build/_deps/cim-data-src/WSCC-09/WSCC-09_RX", "CIMPATH");
+
+	Int numCopies = 10;
+	Int maxThreads = 32;
+	Real duration = 0.1;
+
+	if (args.options.find("copies") != args.options.end())
+		numCopies = args.getOptionInt("copies");
+	if (args.options.find("maxThreads") != args.options.end())
+		maxThreads = args.getOptionInt("maxThreads");
+	if (args.options.find("duration") != args.options.end())
+		duration = args.getOptionReal("duration");
+
+	std::vector<String> schedulers = {
+#ifdef WITH_OPENMP
+		"openmp_level",
+#endif
+		"thread_level", "thread_list", "work_stealing"
+	};
+
+	// Step times in nanoseconds
+	std::cout << "scheduler,threads,mean,p50,p99,max" << std::endl;
+	simulate(filenames, "sequential", numCopies, 1, duration);
+	for (auto& scheduler : schedulers) {
+		for (Int threads = 1; threads <= maxThreads; threads *= 2)
+			simulate(filenames, scheduler, numCopies, threads, duration);
+	}
+}
@@ -0,0 +1,111 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+// Compares the throughput of scenarios of an RL ladder that only differ in
+// their source voltage, simulated one after the other and as an ensemble
+// in lockstep. Options: scenarios (default 32), sections (default 100),
+// duration (default 0.1)
+
+#include <chrono>
+#include <iostream>
+
+#include <DPsim.h>
+
+using namespace DPsim;
+using namespace CPS::DP;
+using namespace CPS::DP::Ph1;
+
+SystemTopology ladder(const String& prefix, UInt sections, Complex voltage) {
+	auto sys = SystemTopology(50);
+
+	auto n1 = SimNode::make(prefix + "n0");
+	auto vs = VoltageSource::make(prefix + "vs");
+	vs->setParameters(voltage);
+	vs->connect(SimNode::List{ SimNode::GND, n1 });
+	sys.addNode(n1);
+	sys.addComponent(vs);
+
+	for (UInt i = 1; i <= sections; ++i) {
+		auto n2 = SimNode::make(prefix + "n" + std::to_string(i));
+		auto r = Resistor::make(prefix + "r_" + std::to_string(i));
+		r->setParameters(0.5);
+		auto l = Inductor::make(prefix + "l_" + std::to_string(i));
+		l->setParameters(0.001);
+		auto n3 = SimNode::make(prefix + "m" + std::to_string(i));
+		auto load = Resistor::make(prefix + "load_" + std::to_string(i));
+		load->setParameters(100);
+
+		r->connect(SimNode::List{ n1, n3 });
+		l->connect(SimNode::List{ n3, n2 });
+		load->connect(SimNode::List{ n2, SimNode::GND });
+		sys.addNode(n3);
+		sys.addNode(n2);
+		sys.addComponent(r);
+		sys.addComponent(l);
+		sys.addComponent(load);
+		n1 = n2;
+	}
+	return sys;
+}
+
+Complex scenarioVoltage(UInt scenario) {
+	return Complex(10 + 0.1 * scenario, 0);
+}
+
+int main(int argc, char* argv[]) {
+	CommandLineArgs args(argc, argv);
+
+	UInt numScenarios = 32;
+	UInt numSections = 100;
+	Real duration = 0.1;
+	if (args.options.find("scenarios") != args.options.end())
+		numScenarios = args.getOptionInt("scenarios");
+	if (args.options.find("sections") != args.options.end())
+		numSections = args.getOptionInt("sections");
+	if (args.options.find("duration") != args.options.end())
+		duration = args.getOptionReal("duration");
+
+	Real timeStep = 0.0001;
+	Real numSteps = duration / timeStep;
+	String simName = "DP_Ensemble_Benchmark";
+	Logger::setLogDir("logs/" + simName);
+
+	// Independent simulations
+	auto start = std::chrono::steady_clock::now();
+	for (UInt i = 0; i < numScenarios; ++i) {
+		Simulation sim(simName + "_single", Logger::Level::off);
+		sim.setSystem(ladder("s" + std::to_string(i) + "_", numSections, scenarioVoltage(i)));
+		sim.setTimeStep(timeStep);
+		sim.setFinalTime(duration);
+		sim.run();
+	}
+	std::chrono::duration<Real> single = std::chrono::steady_clock::now() - start;
+
+	// Ensemble with the first scenario as system
+	start = std::chrono::steady_clock::now();
+	std::vector<SystemTopology> scenarios;
+	for (UInt i = 1; i < numScenarios; ++i)
+		scenarios.push_back(ladder("e" + std::to_string(i) + "_", numSections, scenarioVoltage(i)));
+
+	Simulation sim(simName + "_ensemble", Logger::Level::off);
+	sim.setSystem(ladder("e0_", numSections, scenarioVoltage(0)));
+	sim.setEnsemble(scenarios);
+	sim.setTimeStep(timeStep);
+	sim.setFinalTime(duration);
+	sim.run();
+	std::chrono::duration<Real> ensemble = std::chrono::steady_clock::now() - start;
+
+	// Scenario steps per second
+	std::cout << "mode,scenarios,seconds,throughput" << std::endl;
+	std::cout << "single," << numScenarios << "," << single.count() << ","
+		<< numScenarios * numSteps / single.count() << std::endl;
+	std::cout << "ensemble," << numScenarios << "," << ensemble.count() << ","
+		<< numScenarios * numSteps / ensemble.count() << std::endl;
+
+	return 0;
+}
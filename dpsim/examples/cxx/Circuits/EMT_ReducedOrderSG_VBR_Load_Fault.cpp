@@ -164,6 +164,7 @@ int main(int argc, char* argv[]) {
 	auto sw2 = SwitchEvent3Ph::make(endTimeFault, fault, false);
 	simEMT.addEvent(sw2);
 	
+	simEMT.doStepTimeRecording(true);
 	simEMT.run();
 	simEMT.logStepTimes(simNameEMT + "_step_times");
 }
\ No newline at end of file
@@ -0,0 +1,140 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+// Checks that the in-place solves of the MNA solvers do not allocate. The
+// allocation functions of the C library are counted while the solves of
+// real, complex and dense factorizations run, also with several right side
+// vectors. Exits with 1 if any of them allocates or deviates from Eigen's
+// solve.
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+
+#include <dpsim/InPlaceSolve.h>
+
+#ifdef __GLIBC__
+extern "C" {
+	void* __libc_malloc(size_t size);
+	void* __libc_calloc(size_t num, size_t size);
+	void* __libc_realloc(void* ptr, size_t size);
+}
+
+static std::atomic<bool> countAllocations { false };
+static std::atomic<std::size_t> numAllocations { 0 };
+
+extern "C" {
+	void* malloc(size_t size) {
+		if (countAllocations)
+			++numAllocations;
+		return __libc_malloc(size);
+	}
+	void* calloc(size_t num, size_t size) {
+		if (countAllocations)
+			++numAllocations;
+		return __libc_calloc(num, size);
+	}
+	void* realloc(void* ptr, size_t size) {
+		if (countAllocations)
+			++numAllocations;
+		return __libc_realloc(ptr, size);
+	}
+}
+#endif
+
+using namespace DPsim;
+
+template <typename Scalar>
+using ColMajorMatrix = Eigen::SparseMatrix<Scalar, Eigen::ColMajor>;
+
+/// Grid of nodes with unsymmetric couplings, similar to a meshed network
+template <typename Scalar>
+ColMajorMatrix<Scalar> gridMatrix(Int width, Scalar coupling) {
+	Int size = width * width;
+	std::vector<Eigen::Triplet<Scalar>> entries;
+	for (Int i = 0; i < size; ++i) {
+		entries.emplace_back(i, i, Scalar(4.5));
+		if (i % width + 1 < width) {
+			entries.emplace_back(i, i + 1, -coupling);
+			entries.emplace_back(i + 1, i, Scalar(-1));
+		}
+		if (i + width < size) {
+			entries.emplace_back(i, i + width, Scalar(-1));
+			entries.emplace_back(i + width, i, -coupling);
+		}
+	}
+	ColMajorMatrix<Scalar> mat(size, size);
+	mat.setFromTriplets(entries.begin(), entries.end());
+	mat.makeCompressed();
+	return mat;
+}
+
+template <typename Solve>
+Bool check(const String& name, Real error, Solve solve) {
+	numAllocations = 0;
+	countAllocations = true;
+	for (Int i = 0; i < 100; ++i)
+		solve();
+	countAllocations = false;
+
+	Bool ok = numAllocations == 0 && error < 1e-10;
+	std::cout << name << ": " << numAllocations << " allocations, error " << error
+		<< (ok ? "" : " FAILED") << std::endl;
+	return ok;
+}
+
+int main(int argc, char* argv[]) {
+#ifndef __GLIBC__
+	std::cout << "Counting allocations requires glibc, skipped" << std::endl;
+	return 0;
+#else
+	Int width = 30;
+	Bool ok = true;
+
+	// Real sparse factorization
+	auto sys = gridMatrix<Real>(width, 1.2);
+	Eigen::SparseLU<ColMajorMatrix<Real>> lu;
+	lu.compute(sys);
+	Matrix rhs = Matrix::Random(sys.rows(), 1);
+	Matrix lhs = Matrix::Zero(sys.rows(), 1);
+	Matrix work = Matrix::Zero(sys.rows(), 1);
+	solveInPlace(lu, rhs, lhs, work);
+	ok &= check("sparse real", (lhs - lu.solve(rhs)).norm(),
+		[&]() { solveInPlace(lu, rhs, lhs, work); });
+
+	// Several right side vectors, as solved for ensembles
+	Matrix rhsCols = Matrix::Random(sys.rows(), 4);
+	Matrix lhsCols = Matrix::Zero(sys.rows(), 4);
+	Matrix workCols = Matrix::Zero(sys.rows(), 4);
+	solveInPlace(lu, rhsCols, lhsCols, workCols);
+	ok &= check("sparse real columns", (lhsCols - lu.solve(rhsCols)).norm(),
+		[&]() { solveInPlace(lu, rhsCols, lhsCols, workCols); });
+
+	// Complex sparse factorization
+	auto sysComp = gridMatrix<Complex>(width, Complex(1.2, 0.3));
+	Eigen::SparseLU<ColMajorMatrix<Complex>> luComp;
+	luComp.compute(sysComp);
+	MatrixComp rhsComp = MatrixComp::Random(sysComp.rows(), 1);
+	MatrixComp lhsComp = MatrixComp::Zero(sysComp.rows(), 1);
+	MatrixComp workComp = MatrixComp::Zero(sysComp.rows(), 1);
+	solveInPlace(luComp, rhsComp, lhsComp, workComp);
+	ok &= check("sparse complex", (lhsComp - luComp.solve(rhsComp)).norm(),
+		[&]() { solveInPlace(luComp, rhsComp, lhsComp, workComp); });
+
+	// Dense factorization
+	Matrix sysDense = Matrix(gridMatrix<Real>(10, 1.2));
+	Eigen::PartialPivLU<Matrix> luDense(sysDense);
+	Matrix rhsDense = Matrix::Random(sysDense.rows(), 1);
+	Matrix lhsDense = Matrix::Zero(sysDense.rows(), 1);
+	solveInPlace(luDense, rhsDense, lhsDense);
+	ok &= check("dense", (lhsDense - luDense.solve(rhsDense)).norm(),
+		[&]() { solveInPlace(luDense, rhsDense, lhsDense); });
+
+	return ok ? 0 : 1;
+#endif
+}
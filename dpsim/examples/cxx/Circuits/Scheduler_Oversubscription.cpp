@@ -0,0 +1,131 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+// Runs a layered task graph with four times more threads than CPUs, so
+// that waiting threads have to park to let the others progress. Checks the
+// results of the threaded schedulers against a sequential run and exits
+// with 1 if they differ. Options: steps (default 2000), threads (default
+// four per CPU)
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include <DPsim.h>
+#include <dpsim/SequentialScheduler.h>
+#include <dpsim/ThreadLevelScheduler.h>
+#include <dpsim/WorkStealingScheduler.h>
+
+using namespace DPsim;
+using namespace CPS;
+
+/// Averages the values of two tasks of the previous layer
+class LayerTask : public Task {
+public:
+	LayerTask(const String& name, std::vector<Real>& values, UInt idx, UInt first, UInt second) :
+		Task(name), mValues(values), mIdx(idx), mFirst(first), mSecond(second) { }
+
+	void execute(Real time, Int timeStepCount) {
+		mValues[mIdx] = 0.5 * (mValues[mFirst] + mValues[mSecond]) + timeStepCount;
+	}
+
+private:
+	std::vector<Real>& mValues;
+	UInt mIdx;
+	UInt mFirst;
+	UInt mSecond;
+};
+
+/// Layers of width tasks, each depending on two tasks of the layer before.
+/// The last layer leads to the root task of the scheduler.
+void createGraph(Scheduler& scheduler, UInt layers, UInt width, std::vector<Real>& values,
+	Task::List& tasks, Scheduler::Edges& inEdges, Scheduler::Edges& outEdges) {
+	values.assign(layers * width, 1);
+	for (UInt layer = 0; layer < layers; ++layer) {
+		for (UInt i = 0; i < width; ++i) {
+			UInt idx = layer * width + i;
+			UInt first = layer == 0 ? idx : idx - width;
+			UInt second = layer == 0 ? idx : (layer - 1) * width + (i + 1) % width;
+			auto task = std::make_shared<LayerTask>("task_" + std::to_string(idx), values, idx, first, second);
+			tasks.push_back(task);
+			if (layer == 0)
+				continue;
+			for (UInt pred : { first, second }) {
+				inEdges[task].push_back(tasks[pred]);
+				outEdges[tasks[pred]].push_back(task);
+			}
+		}
+	}
+
+	// The tasks do not share attributes, so resolveDeps only appends the root task
+	scheduler.resolveDeps(tasks, inEdges, outEdges);
+	auto root = tasks.back();
+	for (UInt i = (layers - 1) * width; i < layers * width; ++i) {
+		inEdges[root].push_back(tasks[i]);
+		outEdges[tasks[i]].push_back(root);
+	}
+}
+
+Bool run(const String& name, Scheduler& scheduler, Int steps, const std::vector<Real>& expected) {
+	std::vector<Real> values;
+	Task::List tasks;
+	Scheduler::Edges inEdges, outEdges;
+	createGraph(scheduler, 8, 16, values, tasks, inEdges, outEdges);
+
+	scheduler.createSchedule(tasks, inEdges, outEdges);
+	auto start = std::chrono::steady_clock::now();
+	for (Int step = 0; step < steps; ++step)
+		scheduler.step(step, step);
+	std::chrono::duration<Real> duration = std::chrono::steady_clock::now() - start;
+	scheduler.stop();
+
+	Bool ok = values == expected;
+	std::cout << name << ": " << steps / duration.count() << " steps/s"
+		<< (ok ? "" : " FAILED") << std::endl;
+	return ok;
+}
+
+int main(int argc, char* argv[]) {
+	CommandLineArgs args(argc, argv);
+
+	Int steps = 2000;
+	Int threads = 4 * std::max<Int>(std::thread::hardware_concurrency(), 1);
+	if (args.options.find("steps") != args.options.end())
+		steps = args.getOptionInt("steps");
+	if (args.options.find("threads") != args.options.end())
+		threads = args.getOptionInt("threads");
+
+	// Sequential reference
+	std::vector<Real> expected;
+	Task::List tasks;
+	Scheduler::Edges inEdges, outEdges;
+	SequentialScheduler sequentialScheduler;
+	createGraph(sequentialScheduler, 8, 16, expected, tasks, inEdges, outEdges);
+	sequentialScheduler.createSchedule(tasks, inEdges, outEdges);
+	for (Int step = 0; step < steps; ++step)
+		sequentialScheduler.step(step, step);
+
+	// Short spinning, so that the threads park soon
+	WaitPolicy policy;
+	policy.spinCount = 16;
+	policy.pauseCount = 256;
+	policy.park = true;
+
+	std::cout << threads << " threads on " << std::thread::hardware_concurrency() << " CPUs" << std::endl;
+	Bool ok = true;
+
+	ThreadLevelScheduler levelScheduler(threads);
+	levelScheduler.setWaitPolicy(policy);
+	ok &= run("level scheduler", levelScheduler, steps, expected);
+
+	WorkStealingScheduler stealingScheduler(threads);
+	stealingScheduler.setWaitPolicy(policy);
+	ok &= run("work stealing scheduler", stealingScheduler, steps, expected);
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,146 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+// Per-step cost of the PLL and power controller state space updates of an
+// average voltage source inverter, once with Math::StateSpaceTrapezoidal
+// and once with precomputed DiscreteStateSpace kernels.
+// Options: steps (default 1000000)
+
+#include <chrono>
+#include <iostream>
+
+#include <DPsim.h>
+#include <dpsim-models/DiscreteStateSpace.h>
+
+using namespace DPsim;
+using namespace CPS;
+
+// Controller parameters of the inverter examples
+const Real timeStep = 1e-4;
+const Real omegaNom = 2 * PI * 50;
+const Real KpPLL = 0.25;
+const Real KiPLL = 0.2;
+const Real KpPowerCtrl = 0.001;
+const Real KiPowerCtrl = 0.008;
+const Real KpCurrCtrl = 0.3;
+const Real KiCurrCtrl = 1;
+const Real omegaCutoff = 2 * PI * 50;
+
+struct Models {
+	Matrix pllA = Matrix::Zero(2, 2);
+	Matrix pllB = Matrix::Zero(2, 2);
+	Matrix pcA = Matrix::Zero(6, 6);
+	Matrix pcB = Matrix::Zero(6, 6);
+
+	Models() {
+		pllA << 0, KiPLL,
+			0, 0;
+		pllB << 1, KpPLL,
+			0, 1;
+		pcA <<
+			-omegaCutoff, 0, 0, 0, 0, 0,
+			0, -omegaCutoff, 0, 0, 0, 0,
+			-1, 0, 0, 0, 0, 0,
+			0, 1, 0, 0, 0, 0,
+			-KpPowerCtrl, 0, KiPowerCtrl, 0, 0, 0,
+			0, KpPowerCtrl, 0, KiPowerCtrl, 0, 0;
+		pcB <<
+			0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0,
+			1, 0, 0, 0, 0, 0,
+			0, -1, 0, 0, 0, 0,
+			KpPowerCtrl, 0, 0, 0, -1, 0,
+			0, -KpPowerCtrl, 0, 0, 0, -1;
+	}
+
+	// The power controller input matrix depends on the filter current
+	void updateB(Real ircD, Real ircQ) {
+		pcB(0, 2) = omegaCutoff * ircD;
+		pcB(0, 3) = omegaCutoff * ircQ;
+		pcB(1, 2) = -omegaCutoff * ircQ;
+		pcB(1, 3) = omegaCutoff * ircD;
+	}
+};
+
+// Synthetic measurements of a grid-connected inverter
+void inputs(Int step, Matrix& pllU, Matrix& pcU, Real& ircD, Real& ircQ) {
+	Real t = step * timeStep;
+	Real vq = 0.01 * std::sin(2 * PI * 5 * t);
+	ircD = 10 + std::sin(2 * PI * 3 * t);
+	ircQ = 0.5 * std::cos(2 * PI * 3 * t);
+	pllU << omegaNom, vq;
+	pcU << 1e4, 0, 230 + vq, vq, ircD, ircQ;
+}
+
+template <typename Step>
+Real measure(Int steps, Step step) {
+	auto start = std::chrono::steady_clock::now();
+	for (Int i = 0; i < steps; i++)
+		step(i);
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<Real, std::nano>(end - start).count() / steps;
+}
+
+int main(int argc, char* argv[]) {
+	CommandLineArgs args(argc, argv);
+
+	Int steps = 1000000;
+	if (args.options.find("steps") != args.options.end())
+		steps = args.getOptionInt("steps");
+
+	Real ircD, ircQ;
+
+	// Before: factorization and products with dynamic matrices in every step
+	Models legacy;
+	Matrix pllX = Matrix::Zero(2, 1), pllU = Matrix::Zero(2, 1), pllUPrev = Matrix::Zero(2, 1);
+	Matrix pcX = Matrix::Zero(6, 1), pcU = Matrix::Zero(6, 1), pcUPrev = Matrix::Zero(6, 1);
+	inputs(0, pllUPrev, pcUPrev, ircD, ircQ);
+	Real legacyTime = measure(steps, [&](Int i) {
+		inputs(i, pllU, pcU, ircD, ircQ);
+		legacy.updateB(ircD, ircQ);
+		pllX = Math::StateSpaceTrapezoidal(pllX, legacy.pllA, legacy.pllB, timeStep, pllU, pllUPrev);
+		pcX = Math::StateSpaceTrapezoidal(pcX, legacy.pcA, legacy.pcB, timeStep, pcU, pcUPrev);
+		pllUPrev = pllU;
+		pcUPrev = pcU;
+	});
+
+	// After: transition matrices computed once, only B of the power controller is updated
+	Models models;
+	DiscreteStateSpace<2, 2> pll;
+	DiscreteStateSpace<6, 6> pc;
+	inputs(0, pllUPrev, pcUPrev, ircD, ircQ);
+	models.updateB(ircD, ircQ);
+	pll.setParameters(models.pllA, models.pllB, timeStep);
+	pc.setParameters(models.pcA, models.pcB, timeStep);
+
+	DiscreteStateSpace<2, 2>::StateVector pllXFixed = DiscreteStateSpace<2, 2>::StateVector::Zero();
+	DiscreteStateSpace<6, 6>::StateVector pcXFixed = DiscreteStateSpace<6, 6>::StateVector::Zero();
+	DiscreteStateSpace<2, 2>::InputVector pllUFixed, pllUPrevFixed = pllUPrev;
+	DiscreteStateSpace<6, 6>::InputVector pcUFixed, pcUPrevFixed = pcUPrev;
+	Matrix pllUDyn = Matrix::Zero(2, 1), pcUDyn = Matrix::Zero(6, 1);
+	Real fixedTime = measure(steps, [&](Int i) {
+		inputs(i, pllUDyn, pcUDyn, ircD, ircQ);
+		pllUFixed = pllUDyn;
+		pcUFixed = pcUDyn;
+		models.updateB(ircD, ircQ);
+		pc.setInputMatrix(models.pcB);
+		pllXFixed = pll.step(pllXFixed, pllUFixed, pllUPrevFixed);
+		pcXFixed = pc.step(pcXFixed, pcUFixed, pcUPrevFixed);
+		pllUPrevFixed = pllUFixed;
+		pcUPrevFixed = pcUFixed;
+	});
+
+	Real deviation = std::max((pllX - pllXFixed).cwiseAbs().maxCoeff() / std::max(pllX.cwiseAbs().maxCoeff(), 1.),
+		(pcX - pcXFixed).cwiseAbs().maxCoeff() / std::max(pcX.cwiseAbs().maxCoeff(), 1.));
+
+	std::cout << "kernel,ns_per_step" << std::endl;
+	std::cout << "StateSpaceTrapezoidal," << legacyTime << std::endl;
+	std::cout << "DiscreteStateSpace," << fixedTime << std::endl;
+	std::cout << "speedup: " << legacyTime / fixedTime
+		<< ", max relative deviation after " << steps << " steps: " << deviation << std::endl;
+}
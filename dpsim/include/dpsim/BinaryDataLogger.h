@@ -0,0 +1,57 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <dpsim/DataLogger.h>
+
+namespace DPsim {
+
+	/// Data logger writing a binary columnar file instead of CSV.
+	///
+	/// The file starts with a header holding the magic "DPSIMLOG", the format
+	/// version, the number of columns and the type and name of every column.
+	/// It is followed by blocks of up to mBlockRows rows, each starting with
+	/// the row count and storing the time column and then every attribute
+	/// column as contiguous little-endian doubles. The python module
+	/// dpsim.binarylog reads these files and converts them to the CSV written
+	/// by DataLogger.
+	class BinaryDataLogger : public DataLogger, public SharedFactory<BinaryDataLogger> {
+
+	protected:
+		/// Maximum number of rows per block
+		UInt mBlockRows;
+		/// Number of rows in the current block
+		UInt mNumRows = 0;
+		/// Time column of the current block
+		std::vector<Real> mTimes;
+		/// Values of the current block, stored column by column
+		std::vector<Real> mValues;
+
+		/// Resolves the logged attributes and writes the file header
+		void writeHeader();
+		/// Writes the buffered rows as one block
+		void writeBlock();
+		/// Appends a row taken from the ring buffer to the current block
+		void writeRow(Real time, const Real* values) override;
+
+	public:
+		typedef std::shared_ptr<BinaryDataLogger> Ptr;
+		using SharedFactory<BinaryDataLogger>::make;
+
+		BinaryDataLogger(String name, Bool enabled = true, UInt downsampling = 1, UInt blockRows = 1024);
+		virtual ~BinaryDataLogger();
+
+		void open() override;
+		void close() override;
+
+		void log(Real time, Int timeStepCount) override;
+	};
+}
@@ -11,10 +11,13 @@
 #include <map>
 #include <iostream>
 #include <fstream>
+#include <atomic>
+#include <thread>
 #include <experimental/filesystem>
 
 #include <dpsim/Definitions.h>
 #include <dpsim/Scheduler.h>
+#include <dpsim-models/Logger.h>
 #include <dpsim-models/PtrFactory.h>
 #include <dpsim-models/Attribute.h>
 #include <dpsim-models/SimNode.h>
@@ -26,28 +29,107 @@ namespace DPsim {
 
 	class DataLogger : public SharedFactory<DataLogger> {
 
+	public:
+		/// Type of a logged column
+		enum class ColumnType : uint8_t { Real = 0, Int = 1, UInt = 2, Bool = 3 };
+		/// Behaviour of an asynchronous logger when its ring buffer is full
+		enum class FullBufferPolicy {
+			/// Wait for the writer thread to free a row
+			Block,
+			/// Drop the row
+			Drop,
+			/// Drop every second row once the buffer is half full and all rows once it is full
+			Downsample
+		};
+
 	protected:
 		std::ofstream mLogFile;
 		String mName;
 		Bool mEnabled;
 		UInt mDownsampling;
 		fs::path mFilename;
+		/// Logger for warnings about the data logger itself
+		CPS::Logger::Log mSLog;
 
 		std::map<String, CPS::AttributeBase::Ptr> mAttributes;
 
+		/// Logged attribute resolved to its typed attribute
+		struct Column {
+			ColumnType type;
+			/// Attribute of the given type
+			CPS::AttributeBase* attr;
+		};
+		/// Logged attributes in the order of the file columns
+		std::vector<Column> mColumns;
+
+		// #### Asynchronous writing ####
+		/// Write rows from a separate thread
+		Bool mAsync = false;
+		/// Number of rows in the ring buffer
+		UInt mBufferRows = 0;
+		/// Behaviour when the ring buffer is full
+		FullBufferPolicy mFullBufferPolicy = FullBufferPolicy::Block;
+		/// Number of values per row
+		UInt mRowWidth = 0;
+		/// Rows are attribute values instead of node values
+		Bool mAttributeRows = false;
+		/// Time of each row in the ring buffer
+		std::vector<Real> mRingTimes;
+		/// Values of each row in the ring buffer
+		std::vector<Real> mRingValues;
+		/// Number of rows pushed into the ring buffer, only written by the simulation thread
+		std::atomic<std::size_t> mRingHead { 0 };
+		/// Number of rows taken from the ring buffer, only written by the writer thread
+		std::atomic<std::size_t> mRingTail { 0 };
+		/// Number of rows offered while the buffer was at least half full
+		std::size_t mCrowdedRows = 0;
+		/// Number of rows that were not logged because the buffer was full
+		std::atomic<UInt> mDroppedRows { 0 };
+		/// Flag to keep the writer thread running
+		std::atomic<bool> mWriterRunning { false };
+		/// Thread serializing the rows of the ring buffer
+		std::thread mWriterThread;
+
 		void logDataLine(Real time, Real data);
 		void logDataLine(Real time, const Matrix& data);
 		void logDataLine(Real time, const MatrixComp& data);
 
+		/// Resolves the logged attributes to typed columns, returns false if
+		/// an attribute is not a number and can only be written as text
+		Bool resolveColumns();
+		/// Copies the current values of all columns, consecutive values are stride apart
+		void readColumns(Real* values, UInt stride);
+
+		/// Allocates the ring buffer and starts the writer thread
+		void startWriter(UInt rowWidth, Bool attributeRows);
+		/// Writes the remaining rows and stops the writer thread
+		void stopWriter();
+		/// Loop of the writer thread
+		void writeRows();
+		/// Returns the next free row of the ring buffer or nullptr if the row is dropped
+		Real* beginRow(Real time);
+		/// Hands the row returned by beginRow over to the writer thread
+		void commitRow() { mRingHead.store(mRingHead.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+		/// Serializes a row taken from the ring buffer
+		virtual void writeRow(Real time, const Real* values);
+
 	public:
 		typedef std::shared_ptr<DataLogger> Ptr;
 		typedef std::vector<DataLogger::Ptr> List;
 
 		DataLogger(Bool enabled = true);
 		DataLogger(String name, Bool enabled = true, UInt downsampling = 1);
+		virtual ~DataLogger() { stopWriter(); };
+
+		/// Moves the file output to a writer thread. Logging a step only
+		/// copies the values into a ring buffer of preallocated rows.
+		/// Only real and integer attributes can be logged asynchronously.
+		void enableAsync(UInt bufferRows = 4096, FullBufferPolicy policy = FullBufferPolicy::Block);
+		/// Number of rows that were not logged because the ring buffer was full
+		UInt droppedRows() const { return mDroppedRows; }
 
-		void open();
-		void close();
+		virtual void open();
+		virtual void close();
 		void reopen() {
 			close();
 			open();
@@ -63,7 +145,7 @@ namespace DPsim {
 		///DEPRECATED: Only use for compatiblity, otherwise this just adds extra overhead to the logger. Instead just call logAttribute multiple times for every coefficient using `attr->deriveCoeff<>(a,b)`.
 		void logAttribute(const std::vector<String> &name, CPS::AttributeBase::Ptr attr);
 
-		void log(Real time, Int timeStepCount);
+		virtual void log(Real time, Int timeStepCount);
 
 		CPS::Task::Ptr getTask();
 
@@ -0,0 +1,95 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <dpsim/Definitions.h>
+#include <dpsim-models/Logger.h>
+#include <dpsim-models/SystemTopology.h>
+
+namespace DPsim {
+	/// Selects tear components for the DiakopticsSolver.
+	///
+	/// The network is treated as a graph with the nodes as vertices and the
+	/// components as edges. Components that cannot be torn, i.e. that do not
+	/// implement MNATearInterface or connect more than two nodes, are
+	/// contracted first. The remaining graph is partitioned with a multilevel
+	/// scheme: heavy-edge matching while coarsening, recursive bisection by
+	/// graph growing on the coarsest graph and greedy boundary refinement
+	/// while projecting back. The number of torn components is minimized
+	/// while the estimated cost of the subnets is kept balanced.
+	class DiakopticsPartitioner {
+	public:
+		/// Estimated cost of the parts of a subnet
+		struct Weights {
+			/// Cost of a row of the system matrix
+			Real row = 1;
+			/// Cost of a non-zero of the system matrix
+			Real nonZero = 0.5;
+			/// Additional cost of switches and variable components
+			Real nonlinear = 20;
+			/// Allowed relative excess of a subnet's cost over the mean
+			Real imbalance = 0.05;
+		};
+
+		DiakopticsPartitioner(CPS::Logger::Level logLevel = CPS::Logger::Level::info);
+
+		void setWeights(const Weights& weights) { mWeights = weights; }
+
+		/// Split the system into the given number of subnets, or one per
+		/// thread if subnets is zero. If there are more subnets than threads,
+		/// the subnets are sized so that their cost is balanced across the
+		/// threads, e.g. five subnets on four threads are split into three of
+		/// a quarter and two of an eighth of the total cost. The selected
+		/// components are moved from the components to the tear components of
+		/// the system and returned, so they can be passed to
+		/// Simulation::setTearingComponents.
+		template <typename VarType>
+		CPS::IdentifiedObject::List partition(CPS::SystemTopology& system, UInt subnets, UInt threads = 1);
+
+	private:
+		/// Undirected weighted graph in compressed adjacency form
+		struct Graph {
+			std::vector<Real> vertexWeights;
+			/// Neighbours of vertex i are neighbours[offsets[i]] to neighbours[offsets[i+1]-1]
+			std::vector<UInt> offsets;
+			std::vector<UInt> neighbours;
+			std::vector<Real> edgeWeights;
+
+			UInt size() const { return static_cast<UInt>(vertexWeights.size()); }
+			Real totalWeight() const;
+		};
+
+		struct Edge {
+			UInt from;
+			UInt to;
+			Real weight;
+		};
+
+		/// Build a graph, merging parallel edges and dropping self loops
+		static Graph buildGraph(std::vector<Real> vertexWeights, std::vector<Edge>& edges);
+		/// Contract a heavy-edge matching, map gives the coarse vertex of each vertex
+		static Graph coarsen(const Graph& graph, Real maxVertexWeight, std::vector<UInt>& map);
+		/// Recursively bisect the given vertices into parts firstPart to firstPart+parts-1,
+		/// whose weights are proportional to their targets
+		static void bisect(const Graph& graph, const std::vector<UInt>& vertices,
+			UInt firstPart, UInt parts, const std::vector<Real>& targets, std::vector<UInt>& partition);
+		/// Move boundary vertices to neighbouring parts while this reduces the cut
+		/// or the imbalance
+		static void refine(const Graph& graph, const std::vector<Real>& maxPartWeights, std::vector<UInt>& partition);
+		/// Partition a graph into parts with the given fractions of the total weight
+		std::vector<UInt> partitionGraph(const Graph& graph, const std::vector<Real>& targets);
+		/// Fractions of the total cost per subnet that balance the subnets across the threads
+		static std::vector<Real> subnetTargets(UInt parts, UInt threads);
+
+		Weights mWeights;
+		CPS::Logger::Log mSLog;
+	};
+}
@@ -10,6 +10,8 @@
 
 #include <dpsim-models/AttributeList.h>
 #include <dpsim-models/Solver/MNAInterface.h>
+#include <dpsim-models/Solver/MNASwitchInterface.h>
+#include <dpsim-models/Solver/MNAVariableCompInterface.h>
 #include <dpsim-models/SimSignalComp.h>
 #include <dpsim/DataLogger.h>
 #include <dpsim/Solver.h>
@@ -25,6 +27,13 @@ namespace DPsim {
 			typename CPS::SimNode<VarType>::List nodes;
 			/// Components assigned to this subnetwork
 			CPS::MNAInterface::List components;
+			/// Switches and variable components, restamped when one of them changes
+			CPS::MNAInterface::List variableComponents;
+			/// Switches of this subnetwork and their state in the current factorization
+			std::vector<CPS::MNASwitchInterface::Ptr> switches;
+			std::vector<Bool> switchStatus;
+			/// Variable components of this subnetwork
+			std::vector<CPS::MNAVariableCompInterface::Ptr> variableComps;
 			/// Size in system matrix (i.e. including virtual nodes)
 			UInt sysSize;
 			/// Offset for the imaginary part
@@ -35,8 +44,31 @@ namespace DPsim {
 			UInt mVirtualNodeNum;
 			/// Offset of block in system matrix
 			UInt sysOff;
-			/// Factorization of the subnet's block
-			CPS::LUFactorized luFactorization;
+			/// Block of the subnet in the system matrix, row major as the components stamp it
+			SparseMatrix stampMatrix;
+			/// Values of the constant stamps in the pattern of stampMatrix
+			std::vector<Real> baseValues;
+			/// Column major copy of stampMatrix for the factorization
+			CPS::SparseMatrix systemMatrix;
+			/// Position of each value of stampMatrix in systemMatrix
+			std::vector<UInt> systemMatrixIndex;
+			/// Sparse factorization of the subnet's block
+			std::shared_ptr<CPS::LUFactorizedSparse> luFactorization;
+			/// Tear columns incident to this subnet
+			std::vector<UInt> tearColumns;
+			/// Rows of these tear columns in the subnet's block
+			CPS::SparseMatrix tearTopology;
+			/// Contribution to C^T * Y^-1 * C for the incident tear columns
+			Matrix tearImpedance;
+			/// Contribution after a refactorization, not yet added to the total
+			Matrix nextTearImpedance;
+			/// Dense copy of tearTopology as the right side of the solves
+			Matrix tearRightSide;
+			/// Y^-1 * C for the incident tear columns and the work buffer of its solve
+			Matrix tearSolution;
+			Matrix tearSolveWork;
+			/// Set when the factorization changed in the current step
+			Bool changed = false;
 			/// List of all right side vector contributions
 			std::vector<const Matrix*> rightVectorStamps;
 			/// Left-side vector of the subnet AFTER complete step
@@ -60,17 +92,21 @@ namespace DPsim {
 
 		Matrix mRightSideVector;
 		Matrix mLeftSideVector;
-		/// Complete matrix in block form
-		Matrix mSystemMatrix;
-		/// Inverse of the complete system matrix (only used for initialization)
-		Matrix mSystemInverse;
-		/// Topology of the network removal
-		Matrix mTearTopology;
+		/// Topology of the network removal, rows ordered by subnet
+		SparseMatrix mTearTopology;
 		/// Impedance of the removed network
 		Matrix mTearImpedance;
-		/// (Factorization of the) impedance matrix for the removed network, including
-		/// the influence of other subnets
+		/// Impedance matrix for the removed network, including the influence of
+		/// other subnets
+		Matrix mTotalTearImpedanceMatrix;
+		/// Factorization of mTotalTearImpedanceMatrix
 		CPS::LUFactorized mTotalTearImpedance;
+		/// Subnet contributions exchanged in mTotalTearImpedanceMatrix since it
+		/// was last summed up from scratch
+		UInt mTearImpedanceUpdates = 0;
+		/// Number of exchanged contributions after which the roundoff of the
+		/// differences is removed by summing up the total again
+		UInt mTearImpedanceResumInterval = 1000;
 		/// Currents through the removed network
 		Matrix mTearCurrents;
 		/// Voltages across the removed network
@@ -91,7 +127,23 @@ namespace DPsim {
 		void initComponents();
 
 		void initMatrices();
-		void applyTearComponentStamp(UInt compIdx);
+		void applyTearComponentStamp(UInt compIdx, std::vector<Eigen::Triplet<Real>>& topology);
+		/// Stamp the constant components and record their values in the pattern
+		/// including the switches and variable components
+		void createSubnetMatrix(Subnet& net);
+		/// Restamp switches and variable components and refactorize the subnet
+		void updateSubnetMatrix(Subnet& net);
+		/// Compute the tear impedance seen from a subnet, i.e. the block of
+		/// C^T * Y^-1 * C of its tear columns
+		void computeSubnetTearImpedance(Subnet& net);
+		/// Replace the contributions of changed subnets and factorize the
+		/// reduced tear system
+		void factorizeTearImpedance();
+		/// Sum up mTotalTearImpedanceMatrix from the removed network and the
+		/// current contributions of all subnets
+		void sumTearImpedance();
+		/// Check whether a switch or variable component of the subnet changed
+		static Bool hasSubnetChanged(Subnet& net);
 
 		void log(Real time);
 
@@ -106,6 +158,8 @@ namespace DPsim {
 		DiakopticsSolver(String name, CPS::SystemTopology system, CPS::IdentifiedObject::List tearComponents, Real timeStep, CPS::Logger::Level logLevel);
 
 		CPS::Task::List getTasks();
+		///
+		DataLogger::List loggers() override { return { mLeftVectorLog, mRightVectorLog }; }
 
 		class SubnetSolveTask : public CPS::Task {
 		public:
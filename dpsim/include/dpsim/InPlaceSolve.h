@@ -0,0 +1,108 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <type_traits>
+
+#include <dpsim/Definitions.h>
+
+// The sparse in-place solve reads the supernodal factors through members of
+// SparseLU that are not part of Eigen's documented interface. They are known
+// to be available in Eigen 3.3 and 3.4, other versions use SparseLU::solve.
+#if EIGEN_VERSION_AT_LEAST(3,3,0) && !EIGEN_VERSION_AT_LEAST(3,4,90)
+	#define DPSIM_SPARSE_LU_IN_PLACE_SOLVE
+#endif
+
+namespace DPsim {
+
+	/// Solves the right side vectors in the columns of rhs with a sparse LU
+	/// factorization without allocating. Eigen's SparseLU::solve creates
+	/// temporary work vectors in every call, this substitutes the same
+	/// supernodes into preallocated matrices of the size of rhs instead.
+	/// rhs must not alias lhs or work.
+	template <typename Scalar>
+	void solveInPlace(const Eigen::SparseLU<Eigen::SparseMatrix<Scalar, Eigen::ColMajor>>& lu,
+		const MatrixVar<Scalar>& rhs, MatrixVar<Scalar>& lhs, MatrixVar<Scalar>& work) {
+#ifndef DPSIM_SPARSE_LU_IN_PLACE_SOLVE
+		lhs = lu.solve(rhs);
+#else
+		using Block = Eigen::Map<const MatrixVar<Scalar>, 0, Eigen::OuterStride<>>;
+		using Segment = Eigen::Map<Eigen::Matrix<Scalar, Eigen::Dynamic, 1>>;
+		const auto& L = lu.matrixL().m_mapL;
+		const auto& U = lu.matrixU().m_mapU;
+		const Scalar* values = L.valuePtr();
+
+		work.noalias() = lu.rowsPermutation() * rhs;
+
+		// Columns are substituted one after the other, as Eigen solves
+		// triangular blocks with several columns in a temporary buffer
+		for (Eigen::Index c = 0; c < rhs.cols(); ++c) {
+			// Forward substitution with L, the column of lhs holds the updates of a supernode
+			for (Eigen::Index k = 0; k <= L.nsuper(); ++k) {
+				Eigen::Index fsupc = L.supToCol()[k];
+				Eigen::Index istart = L.rowIndexPtr()[fsupc];
+				Eigen::Index nsupc = L.supToCol()[k + 1] - fsupc;
+				Eigen::Index nrow = L.rowIndexPtr()[fsupc + 1] - istart - nsupc;
+
+				if (nsupc == 1) {
+					typename std::decay<decltype(L)>::type::InnerIterator it(L, fsupc);
+					// Skip the unit diagonal
+					for (++it; it; ++it)
+						work(it.row(), c) -= work(fsupc, c) * it.value();
+				}
+				else {
+					Eigen::Index luptr = L.colIndexPtr()[fsupc];
+					Eigen::Index lda = L.colIndexPtr()[fsupc + 1] - luptr;
+					Segment x(&work(fsupc, c), nsupc);
+					Segment updates(&lhs(0, c), nrow);
+					Block(&values[luptr], nsupc, nsupc, Eigen::OuterStride<>(lda))
+						.template triangularView<Eigen::UnitLower>().solveInPlace(x);
+					updates.noalias() = Block(&values[luptr + nsupc], nrow, nsupc, Eigen::OuterStride<>(lda)) * x;
+					for (Eigen::Index i = 0; i < nrow; ++i)
+						work(L.rowIndex()[istart + nsupc + i], c) -= updates(i);
+				}
+			}
+
+			// Backward substitution with U, whose supernodes are stored with L
+			for (Eigen::Index k = L.nsuper(); k >= 0; --k) {
+				Eigen::Index fsupc = L.supToCol()[k];
+				Eigen::Index nsupc = L.supToCol()[k + 1] - fsupc;
+				Eigen::Index luptr = L.colIndexPtr()[fsupc];
+				Eigen::Index lda = L.colIndexPtr()[fsupc + 1] - luptr;
+
+				if (nsupc == 1) {
+					work(fsupc, c) /= values[luptr];
+				}
+				else {
+					Segment x(&work(fsupc, c), nsupc);
+					Block(&values[luptr], nsupc, nsupc, Eigen::OuterStride<>(lda))
+						.template triangularView<Eigen::Upper>().solveInPlace(x);
+				}
+				for (Eigen::Index col = fsupc; col < fsupc + nsupc; ++col) {
+					for (typename std::decay<decltype(U)>::type::InnerIterator it(U, col); it; ++it)
+						work(it.index(), c) -= work(col, c) * it.value();
+				}
+			}
+		}
+
+		lhs.noalias() = lu.colsPermutation().inverse() * work;
+#endif
+	}
+
+	/// Solves a single right side vector with a dense LU factorization without
+	/// allocating. The triangular solves work on a vector view, because Eigen
+	/// solves matrices with a dynamic number of columns blockwise in a
+	/// temporary buffer. rhs must not alias lhs.
+	inline void solveInPlace(const Eigen::PartialPivLU<Matrix>& lu, const Matrix& rhs, Matrix& lhs) {
+		lhs.noalias() = lu.permutationP() * rhs;
+		Eigen::Map<Eigen::Matrix<Real, Eigen::Dynamic, 1>> x(lhs.data(), lhs.rows());
+		lu.matrixLU().triangularView<Eigen::UnitLower>().solveInPlace(x);
+		lu.matrixLU().triangularView<Eigen::Upper>().solveInPlace(x);
+	}
+}
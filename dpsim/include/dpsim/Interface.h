@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <limits>
 #include <thread>
 
 #include <dpsim-models/Logger.h>
@@ -24,13 +25,19 @@ namespace DPsim {
 	public:
 		typedef std::shared_ptr<Interface> Ptr;
 
+		/// Slot ID of packets whose value does not belong to the preallocated export slots
+		static constexpr UInt NO_EXPORT_SLOT = std::numeric_limits<UInt>::max();
+
 		using AttributePacket = struct AttributePacket {
 			CPS::AttributeBase::Ptr value;
 			UInt attributeId; //Used to identify the attribute. Defined by the position in the `mExportAttrsDpsim` and `mImportAttrsDpsim` lists
 			UInt sequenceId; //Increasing ID used to discern multiple consecutive updates of a single attribute
 			unsigned char flags; //Bit 0 set: Close interface
+			UInt slotId = NO_EXPORT_SLOT; //Index of the export slot holding `value`, returned to the pool once the worker is done with it
 		};
 
+		using FreeSlotQueue = moodycamel::ReaderWriterQueue<UInt>;
+
 		enum AttributePacketFlags {
 			PACKET_NO_FLAGS = 0,
 			PACKET_CLOSE_INTERFACE = 1,
@@ -63,6 +70,13 @@ namespace DPsim {
 
 		void setLogger(CPS::Logger::Log log);
 
+		/// Pin the reader and writer threads to a CPU, call it after open()
+		void pinThreads(Int cpu);
+
+		/// Set the number of preallocated value slots per exported attribute.
+		/// Exports only fall back to allocating a new value if the worker holds on to all slots of an attribute.
+		void setExportSlots(UInt numSlots) { mNumExportSlots = numSlots > 0 ? numSlots : 1; }
+
 		virtual ~Interface() {
 			if (mOpened)
 				close();
@@ -89,6 +103,16 @@ namespace DPsim {
 		std::shared_ptr<moodycamel::BlockingReaderWriterQueue<AttributePacket>> mQueueDpsimToInterface;
 		std::shared_ptr<moodycamel::BlockingReaderWriterQueue<AttributePacket>> mQueueInterfaceToDpsim;
 
+		/// Number of preallocated value slots per exported attribute
+		UInt mNumExportSlots = 8;
+		/// Preallocated copies of the exported values, mNumExportSlots consecutive slots per export
+		std::vector<CPS::AttributeBase::Ptr> mExportSlots;
+		/// Free slots of every export, filled by the writer thread and drained by the simulation thread
+		std::vector<std::shared_ptr<FreeSlotQueue>> mFreeExportSlots;
+
+		/// Allocates the export slots, called before the writer thread is started
+		void createExportSlots();
+
 		virtual void addImport(CPS::AttributeBase::Ptr attr, bool blockOnRead = false, bool syncOnSimulationStart = true);
 		virtual void addExport(CPS::AttributeBase::Ptr attr);
 
@@ -98,14 +122,20 @@ namespace DPsim {
 			private:
 				std::shared_ptr<moodycamel::BlockingReaderWriterQueue<AttributePacket>> mQueueDpsimToInterface;
 				std::shared_ptr<InterfaceWorker> mInterfaceWorker;
+				std::vector<std::shared_ptr<FreeSlotQueue>> mFreeExportSlots;
+
+				/// Returns the slots of all offered packets the worker did not keep
+				void releaseSlots(const std::vector<AttributePacket>& offered, const std::vector<AttributePacket>& kept) const;
 
 			public:
 				WriterThread(
 						std::shared_ptr<moodycamel::BlockingReaderWriterQueue<AttributePacket>> queueDpsimToInterface,
-				 		std::shared_ptr<InterfaceWorker> intf
+				 		std::shared_ptr<InterfaceWorker> intf,
+						std::vector<std::shared_ptr<FreeSlotQueue>> freeExportSlots = {}
 					) :
 					mQueueDpsimToInterface(queueDpsimToInterface),
-					mInterfaceWorker(intf) {};
+					mInterfaceWorker(intf),
+					mFreeExportSlots(freeExportSlots) {};
 				void operator() () const;
 		};
  
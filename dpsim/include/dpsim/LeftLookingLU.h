@@ -0,0 +1,123 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <dpsim/Definitions.h>
+
+namespace DPsim {
+
+	/// Sparse LU factorization in the style of KLU for circuit matrices.
+	///
+	/// The matrix is permuted to block upper triangular form by a maximum
+	/// transversal and its strongly connected components, each diagonal block
+	/// is ordered by approximate minimum degree and factorized column by column
+	/// with the left-looking Gilbert-Peierls algorithm and partial pivoting.
+	/// Off-diagonal blocks are not factorized but used in the block back
+	/// substitution. Since column k of the factors only depends on the
+	/// columns up to k of the matrix, a change of values in some columns is
+	/// refactorized from the first changed column of each affected block on,
+	/// keeping the pivot order and the sparsity pattern of the factors.
+	class LeftLookingLU {
+	public:
+		/// Computes the block triangular form and the fill-reducing ordering
+		void analyzePattern(const CPS::SparseMatrix& mat);
+		/// Factorizes the matrix with partial pivoting, which fixes the
+		/// pivot order and pattern for refactorize
+		void factorize(const CPS::SparseMatrix& mat);
+		/// Recomputes the factors of all columns with the previous pivot
+		/// order, returns false if a pivot became too small
+		Bool refactorize(const CPS::SparseMatrix& mat);
+		/// Recomputes the factors of the blocks containing the given matrix
+		/// columns from the first of them on, returns false if a pivot
+		/// became too small
+		Bool refactorize(const CPS::SparseMatrix& mat, const std::vector<UInt>& columns);
+		/// Solves for a single right side vector without allocating.
+		/// rhs must not alias lhs.
+		void solveInPlace(const Matrix& rhs, Matrix& lhs);
+
+		/// True if the matrix has the pattern given to analyzePattern
+		Bool hasPattern(const CPS::SparseMatrix& mat) const;
+		/// True if the factors belong to the current values
+		Bool isFactorized() const { return mFactorized; }
+		/// Dimension of the matrix
+		UInt rows() const { return mSize; }
+		/// Number of diagonal blocks of the block triangular form
+		UInt numBlocks() const { return static_cast<UInt>(mBlockStart.size()) - 1; }
+		/// Position of a matrix column in the factorization order
+		UInt columnPosition(UInt col) const { return mColPos[col]; }
+		/// Number of stored entries of L, U and the off-diagonal blocks
+		std::size_t nonZeros() const { return mLx.size() + mUx.size() + mFx.size(); }
+		/// Number of columns recomputed by the last refactorization
+		UInt lastRefactorizedColumns() const { return mLastRefactorizedColumns; }
+
+	private:
+		/// Factorizes a diagonal block with partial pivoting
+		void factorizeBlock(UInt block, const CPS::SparseMatrix& mat);
+		/// Recomputes a diagonal block from the given position on
+		Bool refactorizeBlock(UInt block, Int from, const CPS::SparseMatrix& mat);
+		/// Depth-first search from a row through the columns of L, pushes
+		/// the reached rows onto mReach in topological order
+		void reach(Int start, Int mark, Int& top);
+
+		UInt mSize = 0;
+		Bool mFactorized = false;
+		UInt mLastRefactorizedColumns = 0;
+		/// Relative size below which the matched row is not used as pivot
+		Real mPivotTolerance = 1e-3;
+
+		/// Pattern given to analyzePattern
+		std::vector<Int> mPatternOuter;
+		std::vector<Int> mPatternInner;
+
+		// #### Ordering of analyzePattern ####
+		/// Matrix column at each position
+		std::vector<Int> mColOrder;
+		/// Position of each matrix column
+		std::vector<Int> mColPos;
+		/// Matrix row matched to the column at each position
+		std::vector<Int> mMatchedRow;
+		/// Position of each matrix row before pivoting
+		std::vector<Int> mRowAnalysisPos;
+		/// First position of each block, followed by the dimension
+		std::vector<Int> mBlockStart;
+		/// Block of each position
+		std::vector<Int> mBlockOf;
+
+		// #### Pivoting of factorize ####
+		/// Pivot position of each position of analyzePattern, -1 before it is pivotal
+		std::vector<Int> mPinv;
+		/// Matrix row pivotal at each position
+		std::vector<Int> mPivotRow;
+
+		// #### Factors by position ####
+		/// Strictly lower part of L with unit diagonal
+		std::vector<Int> mLp;
+		std::vector<Int> mLi;
+		std::vector<Real> mLx;
+		/// U in topological order of the updates, with the diagonal last
+		std::vector<Int> mUp;
+		std::vector<Int> mUi;
+		std::vector<Real> mUx;
+		/// Entries of the off-diagonal blocks
+		std::vector<Int> mFp;
+		std::vector<Int> mFi;
+		std::vector<Real> mFx;
+
+		// #### Work arrays ####
+		std::vector<Real> mX;
+		std::vector<Int> mMark;
+		std::vector<Int> mReach;
+		std::vector<Int> mStack;
+		std::vector<Int> mStackPos;
+		std::vector<Int> mBlockFrom;
+		Matrix mWork;
+	};
+}
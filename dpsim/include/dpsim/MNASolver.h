@@ -62,6 +62,9 @@ namespace DPsim {
 		CPS::SystemTopology mSystem;
 		/// List of simulation nodes
 		typename CPS::SimNode<VarType>::List mNodes;
+		/// True if the network nodes update their voltages in their own tasks
+		/// instead of the solve task
+		Bool mNodeVoltageTasks = false;
 
 		// #### MNA specific attributes ####
 		/// List of MNA components with static stamp into system matrix
@@ -80,6 +83,13 @@ namespace DPsim {
 		Matrix mRightSideVector;
 		/// List of all right side vector contributions
 		std::vector<const Matrix*> mRightVectorStamps;
+		/// Rows of the right side vector that the stamp with the same position
+		/// in mRightVectorStamps can contribute to
+		std::vector<std::vector<UInt>> mRightVectorStampRows;
+		/// Component names of the stamps in mRightVectorStamps
+		std::vector<String> mRightVectorStampNames;
+		/// Set once a stamp had values and they were all in its rows
+		std::vector<Bool> mRightVectorStampChecked;
 
 		// #### MNA specific attributes related to harmonics / additional frequencies ####
 		/// Source vector of known quantities
@@ -101,6 +111,12 @@ namespace DPsim {
 		std::vector<SwitchConfiguration> mSwitchEvents;
 		/// Collects the status of switches to select correct system matrix
 		void updateSwitchStatus();
+		/// Registers the right vector attribute of a component as stamp
+		/// and determines the rows it can contribute to
+		void addRightVectorStamp(CPS::MNAInterface::Ptr comp);
+		/// Adds the right vector stamps of all components to the source vector,
+		/// only touching the rows each stamp contributes to
+		void sumRightVectorStamps();
 
 		// #### Attributes related to logging ####
 		/// Last simulation time step when log was updated
@@ -122,7 +138,7 @@ namespace DPsim {
 		/// Initialization of system matrices and source vector
 		void initializeSystemWithParallelFrequencies();
 		/// Initialization of system matrices and source vector
-		void initializeSystemWithPrecomputedMatrices();
+		virtual void initializeSystemWithPrecomputedMatrices();
 		/// Initialization of system matrices and source vector
 		void initializeSystemWithVariableMatrix();
 		/// Identify Nodes and SimPowerComps and SimSignalComps
@@ -202,6 +218,10 @@ namespace DPsim {
 		Matrix& rightSideVector() { return mRightSideVector; }
 		///
 		virtual CPS::Task::List getTasks() override;
+		///
+		virtual DataLogger::List loggers() override { return { mLeftVectorLog, mRightVectorLog }; }
+		/// Reads the right side vector stamps and the solution vector
+		virtual void warmUp() override;
 
 	};
 }
@@ -17,6 +17,7 @@
 #include <dpsim/Config.h>
 #include <dpsim/Solver.h>
 #include <dpsim/DataLogger.h>
+#include <dpsim/InPlaceSolve.h>
 #include <dpsim-models/AttributeList.h>
 #include <dpsim-models/Solver/MNASwitchInterface.h>
 #include <dpsim-models/Solver/MNAVariableCompInterface.h>
@@ -35,6 +36,10 @@ namespace DPsim {
 		std::unordered_map< std::bitset<SWITCH_NUM>, std::vector<Matrix> > mSwitchedMatrices;
 		/// Map of LU factorizations related to the system matrices
 		std::unordered_map< std::bitset<SWITCH_NUM>, std::vector<CPS::LUFactorized> > mLuFactorizations;
+		/// Switch state whose factorization was used in the last solve
+		std::bitset<SWITCH_NUM> mActiveSwitchStatus;
+		/// Factorization of mActiveSwitchStatus, only looked up when the switch state changes
+		CPS::LUFactorized* mActiveLu = nullptr;
 
 		using MnaSolver<VarType>::mSwitches;
 		using MnaSolver<VarType>::mRightSideVector;
@@ -105,9 +110,6 @@ namespace DPsim {
 					if (it->template attributeTyped<Matrix>("right_vector")->get().size() != 0)
 						mAttributeDependencies.push_back(it->attribute("right_vector"));
 				}
-				for (auto node : solver.mNodes) {
-					mModifiedAttributes.push_back(node->attribute("v"));
-				}
 				mModifiedAttributes.push_back(solver.attribute("left_vector"));
 			}
 
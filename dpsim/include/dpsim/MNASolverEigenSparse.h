@@ -18,6 +18,7 @@
 #include <dpsim/Config.h>
 #include <dpsim/Solver.h>
 #include <dpsim/DataLogger.h>
+#include <dpsim/InPlaceSolve.h>
 #include <dpsim-models/AttributeList.h>
 #include <dpsim-models/Solver/MNASwitchInterface.h>
 #include <dpsim-models/Solver/MNAVariableCompInterface.h>
@@ -38,6 +39,24 @@ namespace DPsim {
 		/// Map of LU factorizations related to the system matrices
 		std::unordered_map< std::bitset<SWITCH_NUM>, std::vector< std::shared_ptr< CPS::LUFactorizedSparse> > > mLuFactorizations;
 
+		// #### Data structures for lazily factorized switch matrices ####
+		/// Cached switch states ordered from most to least recently used
+		std::list< std::bitset<SWITCH_NUM> > mSwitchCacheOrder;
+		/// Position of each cached switch state in mSwitchCacheOrder
+		std::unordered_map< std::bitset<SWITCH_NUM>, std::list< std::bitset<SWITCH_NUM> >::iterator > mSwitchCachePositions;
+		/// Estimated memory of all cached matrices and factorizations in bytes
+		std::size_t mSwitchCacheBytes = 0;
+		/// Estimated memory of each cached switch state, recorded when it is cached
+		std::unordered_map< std::bitset<SWITCH_NUM>, std::size_t > mSwitchCacheEntryBytes;
+		/// Switch state whose factorization was used in the last solve
+		std::bitset<SWITCH_NUM> mActiveSwitchStatus;
+		/// Factorization of mActiveSwitchStatus, only looked up when the switch state changes
+		CPS::LUFactorizedSparse* mActiveLu = nullptr;
+		/// Work vector of the in-place solves
+		Matrix mSolveWork;
+		/// Solution of the warm-up solve, which must not touch the left side vector
+		Matrix mWarmUpVector;
+
 		// #### Data structures for system recomputation over time ####
 		/// System matrix including all static elements
 		SparseMatrix mBaseSystemMatrix;
@@ -45,6 +64,80 @@ namespace DPsim {
 		SparseMatrix mVariableSystemMatrix;
 		/// LU factorization of variable system matrix
 		CPS::LUFactorizedSparse mLuFactorizationVariableSystemMatrix;
+		/// Values of the base system matrix laid out on the sparsity pattern of the variable system matrix
+		std::vector<Real> mBaseSystemValues;
+
+		// #### Data structures for low-rank updates of the variable system matrix ####
+		/// System matrix belonging to mLuFactorizationVariableSystemMatrix
+		SparseMatrix mFactorizedSystemMatrix;
+		/// Columns in which the variable system matrix differs from the factorized one
+		std::vector<UInt> mUpdateColumns;
+		/// Positions of the changed values in the value array and their rows
+		std::vector<std::pair<UInt, UInt>> mUpdateEntries;
+		/// Factorized matrix solved for the changed columns, unused columns are zero
+		Matrix mUpdateSolutions;
+		/// Changed column of the difference and its solution for the in-place solve
+		Matrix mUpdateColumn;
+		Matrix mUpdateColumnSolution;
+		/// Capacitance matrix of the Woodbury update, identity outside of the rank
+		Matrix mUpdateCapacitanceMatrix;
+		/// LU factorization of the capacitance matrix of the Woodbury update
+		Eigen::PartialPivLU<Matrix> mUpdateCapacitance;
+		/// Solution entries in the changed columns
+		Matrix mUpdateSelection;
+		/// Capacitance matrix solved for mUpdateSelection
+		Matrix mUpdateWeights;
+		/// Number of system matrix changes handled by low-rank updates
+		Int mNumLowRankUpdates = 0;
+
+		// #### Data structures for Schur complement updates of the variable system matrix ####
+		/// Entry of the interface block in the variable system matrix
+		struct SchurEntry {
+			UInt row;
+			UInt col;
+			std::size_t valueIdx;
+		};
+		/// True if the variable system matrix is solved through the Schur complement
+		Bool mSchurActive = false;
+		/// Matrix indices touched by switches and variable elements
+		std::vector<UInt> mSchurInterface;
+		/// Matrix indices only touched by static elements
+		std::vector<UInt> mSchurInterior;
+		/// Entries of the interface block in the values of the variable system matrix
+		std::vector<SchurEntry> mSchurEntries;
+		/// LU factorization of the static interior block
+		CPS::LUFactorizedSparse mSchurInteriorLu;
+		/// Block coupling the interface to the interior
+		CPS::SparseMatrix mSchurInterfaceToInterior;
+		/// Interior block solved for the block coupling the interior to the interface
+		Matrix mSchurCoupling;
+		/// Static contribution of the interior to the Schur complement
+		Matrix mSchurStatic;
+		/// Schur complement of the interior block
+		Matrix mSchurComplement;
+		/// LU factorization of the Schur complement
+		Eigen::PartialPivLU<Matrix> mSchurLu;
+		/// Right side, solution and work vector of the interior
+		Matrix mSchurInteriorRhs;
+		Matrix mSchurInteriorVector;
+		Matrix mSchurInteriorWork;
+		/// Right side and solution of the interface
+		Matrix mSchurInterfaceRhs;
+		Matrix mSchurInterfaceVector;
+		/// Number of system matrix changes handled by Schur complement updates
+		Int mNumSchurUpdates = 0;
+
+		// #### Data structures for ensemble simulation ####
+		/// Solvers of further scenarios that are solved together with this one
+		std::vector< std::shared_ptr< MnaSolverEigenSparse<VarType> > > mEnsembleMembers;
+		/// Solver whose factorizations are used if this solver is an ensemble member
+		MnaSolverEigenSparse<VarType>* mEnsembleLeader = nullptr;
+		/// Right side vectors of all scenarios, one column each
+		Matrix mEnsembleRightSide;
+		/// Solution vectors of all scenarios, one column each
+		Matrix mEnsembleLeftSide;
+		/// Work matrix of the in-place solve of all scenarios
+		Matrix mEnsembleWork;
 
 		using MnaSolver<VarType>::mSwitches;
 		using MnaSolver<VarType>::mMNAIntfSwitches;
@@ -63,6 +156,12 @@ namespace DPsim {
 		using MnaSolver<VarType>::mFrequencyParallel;
 		using MnaSolver<VarType>::mSLog;
 		using MnaSolver<VarType>::mSystemMatrixRecomputation;
+		using MnaSolver<VarType>::mLazySwitchFactorization;
+		using MnaSolver<VarType>::mSwitchFactorizationCacheLimit;
+		using MnaSolver<VarType>::mLowRankUpdates;
+		using MnaSolver<VarType>::mLowRankUpdateMaxRank;
+		using MnaSolver<VarType>::mSchurComplementUpdates;
+		using MnaSolver<VarType>::mListVariableSystemMatrixEntries;
 		using MnaSolver<VarType>::hasVariableComponentChanged;
 		using MnaSolver<VarType>::mNumRecomputations;
 
@@ -78,6 +177,22 @@ namespace DPsim {
 		/// Applies a component stamp to the matrix with the given switch index
 		virtual void switchedMatrixStamp(std::size_t index, std::vector<std::shared_ptr<CPS::MNAInterface>>& comp) override;
 
+		// #### Methods for lazily factorized switch matrices ####
+		/// True if switch matrices are factorized on first use
+		Bool isLazySwitchFactorization() const {
+			return mLazySwitchFactorization && !mFrequencyParallel && !mSystemMatrixRecomputation && !isEnsemble();
+		}
+		/// Only factorizes the initial switch state when switch matrices are created lazily
+		virtual void initializeSystemWithPrecomputedMatrices() override;
+		/// Makes the given switch state the active one, factorizing it on a cache miss
+		void activateSwitchStatus(const std::bitset<SWITCH_NUM>& status);
+		/// Points the solve to the factorization of the current switch state
+		virtual void updateActiveFactorization();
+		/// Evicts least recently used switch states until the cache fits its memory limit
+		virtual void evictSwitchMatrices();
+		/// Estimated memory of the matrix and factorization of a cached switch state in bytes
+		virtual std::size_t switchMatrixBytes(const std::bitset<SWITCH_NUM>& status);
+
 		// #### Methods for system recomputation over time ####
 		/// Stamps components into the variable system matrix
 		void stampVariableSystemMatrix() override;
@@ -87,6 +202,32 @@ namespace DPsim {
 		virtual std::shared_ptr<CPS::Task> createSolveTaskRecomp() override;
 		/// Recomputes systems matrix
 		virtual void recomputeSystemMatrix(Real time);
+		/// Compresses the variable system matrix, whose pattern is the union of all stamps,
+		/// and lays out the base system matrix values on that pattern
+		void createVariableSystemPattern();
+		/// Restores the base values of the variable system matrix in place and restamps
+		/// switches and variable elements, returns true if the sparsity pattern changed
+		Bool restampVariableSystemMatrix();
+		/// Prepares a low-rank update for the difference between the variable and the factorized
+		/// system matrix, returns false if the rank exceeds mLowRankUpdateMaxRank
+		Bool updateLowRankCorrection();
+		/// Allocates the work buffers of the low-rank updates for the maximum rank
+		void allocateLowRankUpdates();
+		/// Corrects the solution of the factorized system matrix by the low-rank update
+		void applyLowRankCorrection();
+		/// Splits the variable system matrix into the static interior and the interface of
+		/// switches and variable elements and factorizes the interior block
+		void initializeSchurComplement();
+		/// Refactorizes the Schur complement after the interface block changed
+		void updateSchurComplement();
+		/// Solves the variable system matrix through the Schur complement
+		void solveSchurComplement();
+
+		// #### Methods for ensemble simulation ####
+		/// True if this solver solves further scenarios or is solved by another one
+		Bool isEnsemble() const { return !mEnsembleMembers.empty() || mEnsembleLeader; }
+		/// Solves all scenarios of the ensemble with one multi right side solve
+		void solveEnsemble();
 
 		// #### Scheduler Task Methods ####
 		/// Create a solve task for this solver implementation
@@ -103,14 +244,34 @@ namespace DPsim {
 		virtual void solveWithHarmonics(Real time, Int timeStepCount, Int freqIdx) override;
 
 	public:
+		/// Number of solves that found their switch state factorization in the cache
+		const CPS::Attribute<Int>::Ptr mSwitchCacheHits;
+		/// Number of switch state factorizations computed on demand
+		const CPS::Attribute<Int>::Ptr mSwitchCacheMisses;
+
 		/// Constructor should not be called by users but by Simulation
 		/// sovlerImpl: choose the most advanced solver implementation available by default
 		MnaSolverEigenSparse(String name,
 			CPS::Domain domain = CPS::Domain::DP,
 			CPS::Logger::Level logLevel = CPS::Logger::Level::info);
 
+		/// Adds the solver of a further scenario with the same system matrix,
+		/// whose right side vector is then solved together with the one of this
+		/// solver. Both solvers must not be initialized yet and this one has to
+		/// be initialized first.
+		void addEnsembleMember(std::shared_ptr<MnaSolverEigenSparse<VarType>> member);
+		/// Ensemble members leave their solve to the first solver of the ensemble
+		CPS::Task::List getTasks() override;
+		/// Also runs a solve with the active factorization into mWarmUpVector
+		void warmUp() override;
+
 		/// Destructor
-		virtual ~MnaSolverEigenSparse() { };
+		virtual ~MnaSolverEigenSparse() {
+			if (mSystemMatrixRecomputation && mLowRankUpdates)
+				mSLog->info("Number of low-rank system matrix updates: {:}", mNumLowRankUpdates);
+			if (mSystemMatrixRecomputation && mSchurComplementUpdates)
+				mSLog->info("Number of Schur complement updates: {:}", mNumSchurUpdates);
+		};
 
 		// #### MNA Solver Tasks ####
 		///
@@ -123,10 +284,15 @@ namespace DPsim {
 					if (it->template attributeTyped<Matrix>("right_vector")->get().size() != 0)
 						mAttributeDependencies.push_back(it->attribute("right_vector"));
 				}
-				for (auto node : solver.mNodes) {
-					mModifiedAttributes.push_back(node->attribute("v"));
-				}
 				mModifiedAttributes.push_back(solver.attribute("left_vector"));
+
+				for (auto member : solver.mEnsembleMembers) {
+					for (auto it : member->mMNAComponents) {
+						if (it->template attributeTyped<Matrix>("right_vector")->get().size() != 0)
+							mAttributeDependencies.push_back(it->attribute("right_vector"));
+					}
+					mModifiedAttributes.push_back(member->attribute("left_vector"));
+				}
 			}
 
 			void execute(Real time, Int timeStepCount) { mSolver.solve(time, timeStepCount); }
@@ -174,9 +340,6 @@ namespace DPsim {
 					if (it->template attributeTyped<Matrix>("right_vector")->get().size() != 0)
 						mAttributeDependencies.push_back(it->attribute("right_vector"));
 				}
-				for (auto node : solver.mNodes) {
-					mModifiedAttributes.push_back(node->attribute("v"));
-				}
 				mModifiedAttributes.push_back(solver.attribute("left_vector"));
 			}
 
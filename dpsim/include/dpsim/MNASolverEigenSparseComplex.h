@@ -0,0 +1,107 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <dpsim/MNASolverEigenSparse.h>
+
+namespace DPsim {
+
+	/// Sparse MNA solver factorizing the phasor system in complex arithmetic.
+	///
+	/// DP and SP components stamp each complex admittance as a 2x2 real block
+	/// into a system matrix of twice the number of matrix node indices. This
+	/// solver converts every stamped switch state into a complex matrix of
+	/// half the dimension and a quarter of the non-zeros and only keeps its
+	/// complex LU factorization. The left side vector keeps the layout with
+	/// the real parts followed by the imaginary parts, so components work
+	/// unchanged. For EMT, parallel frequencies, system matrix recomputation,
+	/// ensembles or stamps that are not complex admittances it behaves like
+	/// MnaSolverEigenSparse.
+	template <typename VarType>
+	class MnaSolverEigenSparseComplex : public MnaSolverEigenSparse<VarType> {
+	protected:
+		/// Complex LU factorizations of the switch states
+		std::unordered_map< std::bitset<SWITCH_NUM>, std::shared_ptr<CPS::LUFactorizedSparseComp> > mComplexLuFactorizations;
+		/// Right side vector in complex form
+		MatrixComp mComplexRightSideVector;
+		/// Solution vector in complex form
+		MatrixComp mComplexLeftSideVector;
+		/// Work vector of the in-place solve
+		MatrixComp mComplexSolveWork;
+		/// Solution of the warm-up solve
+		MatrixComp mComplexWarmUpVector;
+		/// Complex factorization of the active switch state
+		CPS::LUFactorizedSparseComp* mActiveComplexLu = nullptr;
+		/// Number of complex unknowns per frequency
+		UInt mComplexBlockSize = 0;
+		/// Number of frequencies, i.e. diagonal blocks in the system matrix
+		UInt mNumComplexBlocks = 0;
+		/// True as long as all switch states are factorized in complex arithmetic
+		Bool mComplexFactorization = false;
+
+		using MnaSolver<VarType>::mSwitches;
+		using MnaSolver<VarType>::mMNAComponents;
+		using MnaSolver<VarType>::mRightSideVector;
+		using MnaSolver<VarType>::mLeftSideVector;
+		using MnaSolver<VarType>::mCurrentSwitchStatus;
+		using MnaSolver<VarType>::mNumNetNodes;
+		using MnaSolver<VarType>::mNumMatrixNodeIndices;
+		using MnaSolver<VarType>::mNodes;
+		using MnaSolver<VarType>::mIsInInitialization;
+		using MnaSolver<VarType>::mFrequencyParallel;
+		using MnaSolver<VarType>::mSystemMatrixRecomputation;
+		using MnaSolver<VarType>::mSystem;
+		using MnaSolver<VarType>::mSLog;
+		using MnaSolverEigenSparse<VarType>::mSwitchedMatrices;
+		using MnaSolverEigenSparse<VarType>::mLuFactorizations;
+		using MnaSolverEigenSparse<VarType>::mSwitchCachePositions;
+		using MnaSolverEigenSparse<VarType>::mSwitchCacheEntryBytes;
+		using MnaSolverEigenSparse<VarType>::mSwitchCacheBytes;
+		using MnaSolverEigenSparse<VarType>::mActiveSwitchStatus;
+		using MnaSolverEigenSparse<VarType>::mActiveLu;
+		using MnaSolverEigenSparse<VarType>::mSolveWork;
+		using MnaSolverEigenSparse<VarType>::isLazySwitchFactorization;
+		using MnaSolverEigenSparse<VarType>::activateSwitchStatus;
+
+		/// Create system matrix and decide whether the complex factorization is used
+		void createEmptySystemMatrix() override;
+		/// Applies a component stamp to the matrix with the given switch index
+		/// and factorizes its complex form, the real matrix is released then
+		void switchedMatrixStamp(std::size_t index, std::vector<std::shared_ptr<CPS::MNAInterface>>& comp) override;
+		/// Evicts the complex factorizations together with the switch matrices
+		void evictSwitchMatrices() override;
+		/// Estimated memory of the matrix and complex factorization of a cached switch state in bytes
+		std::size_t switchMatrixBytes(const std::bitset<SWITCH_NUM>& status) override;
+		/// Points the solve to the complex factorization of the current switch state
+		void updateActiveFactorization() override;
+		/// Solves system for single frequency
+		void solve(Real time, Int timeStepCount) override;
+
+		/// Converts a real system matrix made of complex stamps into complex form,
+		/// returns false if an entry does not belong to a complex admittance
+		Bool convertSystemMatrix(const SparseMatrix& sys, CPS::SparseMatrixComp& sysComp);
+		/// Falls back to the real factorization of all switch states, restamping
+		/// the real matrices that were released after the complex factorization
+		void useRealFactorization();
+
+	public:
+		/// Constructor should not be called by users but by Simulation
+		MnaSolverEigenSparseComplex(String name,
+			CPS::Domain domain = CPS::Domain::DP,
+			CPS::Logger::Level logLevel = CPS::Logger::Level::info) :
+			MnaSolverEigenSparse<VarType>(name, domain, logLevel) { }
+
+		/// Runs the warm-up solve with the complex factorization, as the real
+		/// factorizations are not computed in complex mode
+		void warmUp() override;
+
+		/// Destructor
+		virtual ~MnaSolverEigenSparseComplex() = default;
+	};
+}
@@ -13,6 +13,8 @@
 #include <dpsim/MNASolverEigenDense.h>
 #ifdef WITH_SPARSE
 #include <dpsim/MNASolverEigenSparse.h>
+#include <dpsim/MNASolverEigenSparseComplex.h>
+#include <dpsim/MNASolverLeftLookingSparse.h>
 #endif
 #ifdef WITH_CUDA
 	#include <dpsim/MNASolverGpuDense.h>
@@ -41,6 +43,8 @@ class MnaSolverFactory {
 		CUDASparse,
 		CUDAMagma,
 		Plugin,
+		EigenSparseComplex,
+		LeftLookingSparse,
 	};
 
 	/// MNA implementations supported by this compilation
@@ -51,6 +55,8 @@ class MnaSolverFactory {
 #endif //WITH_MNASOLVERPLUGIN
 			EigenDense,
 #ifdef WITH_SPARSE
+			EigenSparseComplex,
+			LeftLookingSparse,
 			EigenSparse,
 #endif //WITH_SPARSE
 #ifdef WITH_CUDA
@@ -89,6 +95,12 @@ class MnaSolverFactory {
 		case MnaSolverImpl::EigenSparse:
 			log->info("creating EigenSparse solver implementation");
 			return std::make_shared<MnaSolverEigenSparse<VarType>>(name, domain, logLevel);
+		case MnaSolverImpl::EigenSparseComplex:
+			log->info("creating EigenSparseComplex solver implementation");
+			return std::make_shared<MnaSolverEigenSparseComplex<VarType>>(name, domain, logLevel);
+		case MnaSolverImpl::LeftLookingSparse:
+			log->info("creating LeftLookingSparse solver implementation");
+			return std::make_shared<MnaSolverLeftLookingSparse<VarType>>(name, domain, logLevel);
 #endif
 #ifdef WITH_CUDA
 		case MnaSolverImpl::CUDADense:
@@ -0,0 +1,109 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <dpsim/LeftLookingLU.h>
+#include <dpsim/MNASolverEigenSparse.h>
+
+namespace DPsim {
+
+	/// Sparse MNA solver based on a left-looking LU factorization with block
+	/// triangular form.
+	///
+	/// Switch states and changes of variable elements only modify a few columns
+	/// of the system matrix. Instead of factorizing the whole matrix again, the
+	/// factorization is copied from a switch state with the same pattern or
+	/// kept for the variable system matrix and recomputed from the first changed
+	/// column on, so elements late in the ordering only cost a part of the
+	/// factorization. This takes the place of the low-rank and Schur complement
+	/// updates of MnaSolverEigenSparse. Parallel frequencies and ensembles are
+	/// solved like in MnaSolverEigenSparse.
+	template <typename VarType>
+	class MnaSolverLeftLookingSparse : public MnaSolverEigenSparse<VarType> {
+	protected:
+		/// Factorizations of the switch states
+		std::unordered_map< std::bitset<SWITCH_NUM>, std::shared_ptr<LeftLookingLU> > mLeftLookingLus;
+		/// Column-major copies of the switch matrices belonging to mLeftLookingLus
+		std::unordered_map< std::bitset<SWITCH_NUM>, CPS::SparseMatrix > mColumnMatrices;
+		/// Factorization of the active switch state
+		LeftLookingLU* mActiveLeftLookingLu = nullptr;
+		/// Factorization of the variable system matrix
+		LeftLookingLU mVariableLu;
+		/// Column-major copy of the variable system matrix
+		CPS::SparseMatrix mVariableColumnMatrix;
+		/// Position of each value of the variable system matrix in mVariableColumnMatrix
+		std::vector<Int> mColumnValueIdx;
+		/// Columns of the variable system matrix changed since the last factorization
+		std::vector<UInt> mChangedColumns;
+		std::vector<Bool> mColumnChanged;
+		/// Columns recomputed by all refactorizations of the variable system matrix
+		std::size_t mNumRefactorizedColumns = 0;
+		/// False if the solver behaves like MnaSolverEigenSparse
+		Bool mLeftLookingFactorization = false;
+
+		using MnaSolver<VarType>::mSwitches;
+		using MnaSolver<VarType>::mMNAComponents;
+		using MnaSolver<VarType>::mRightSideVector;
+		using MnaSolver<VarType>::mLeftSideVector;
+		using MnaSolver<VarType>::mCurrentSwitchStatus;
+		using MnaSolver<VarType>::mIsInInitialization;
+		using MnaSolver<VarType>::mFrequencyParallel;
+		using MnaSolver<VarType>::mSystemMatrixRecomputation;
+		using MnaSolver<VarType>::mLowRankUpdates;
+		using MnaSolver<VarType>::mSchurComplementUpdates;
+		using MnaSolver<VarType>::hasVariableComponentChanged;
+		using MnaSolver<VarType>::mNumRecomputations;
+		using MnaSolver<VarType>::mSLog;
+		using MnaSolverEigenSparse<VarType>::mSwitchedMatrices;
+		using MnaSolverEigenSparse<VarType>::mSwitchCachePositions;
+		using MnaSolverEigenSparse<VarType>::mActiveSwitchStatus;
+		using MnaSolverEigenSparse<VarType>::mVariableSystemMatrix;
+		using MnaSolverEigenSparse<VarType>::mSchurActive;
+		using MnaSolverEigenSparse<VarType>::mUpdateColumns;
+		using MnaSolverEigenSparse<VarType>::restampVariableSystemMatrix;
+
+		/// Create system matrix
+		void createEmptySystemMatrix() override;
+		/// Drops the factorizations of a previous initialization
+		void initializeSystemWithPrecomputedMatrices() override;
+		/// Applies a component stamp to the matrix with the given switch index
+		/// and factorizes it, starting from a state with the same pattern
+		void switchedMatrixStamp(std::size_t index, std::vector<std::shared_ptr<CPS::MNAInterface>>& comp) override;
+		/// Evicts the factorizations together with the switch matrices
+		void evictSwitchMatrices() override;
+		/// Estimated memory of the matrices and factorization of a cached switch state in bytes
+		std::size_t switchMatrixBytes(const std::bitset<SWITCH_NUM>& status) override;
+		/// Points the solve to the factorization of the current switch state
+		void updateActiveFactorization() override;
+		/// Solves system for single frequency
+		void solve(Real time, Int timeStepCount) override;
+
+		/// Stamps components into the variable system matrix and factorizes it
+		void stampVariableSystemMatrix() override;
+		/// Solves the system with variable system matrix
+		void solveWithSystemMatrixRecomputation(Real time, Int timeStepCount) override;
+		/// Refactorizes the variable system matrix from its first changed column on
+		void recomputeSystemMatrix(Real time) override;
+		/// Copies the variable system matrix to column-major form and factorizes it
+		void factorizeVariableSystemMatrix();
+
+	public:
+		/// Constructor should not be called by users but by Simulation
+		MnaSolverLeftLookingSparse(String name,
+			CPS::Domain domain = CPS::Domain::DP,
+			CPS::Logger::Level logLevel = CPS::Logger::Level::info) :
+			MnaSolverEigenSparse<VarType>(name, domain, logLevel) { }
+
+		/// Destructor
+		virtual ~MnaSolverLeftLookingSparse() {
+			if (mSystemMatrixRecomputation && mLeftLookingFactorization)
+				mSLog->info("Number of refactorized system matrix columns: {:}", mNumRefactorizedColumns);
+		}
+	};
+}
@@ -24,5 +24,7 @@ namespace DPsim {
 		Int mNumThreads;
 		String mOutMeasurementFile;
 		std::vector<CPS::Task::List> mLevels;
+		/// Measurement index of each task in mLevels
+		std::vector<std::vector<UInt>> mLevelMeasurements;
 	};
 };
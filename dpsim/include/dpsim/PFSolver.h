@@ -42,12 +42,18 @@ namespace DPsim {
         std::vector<CPS::UInt> mVDBusIndices;
         /// Vector with indices of both PQ and PV buses
         std::vector<CPS::UInt> mPQPVBusIndices;
+        /// Position of each bus in mPQPVBusIndices or -1 for VD buses
+        std::vector<CPS::Int> mPQPVBusPositions;
 
         /// Admittance matrix
         CPS::SparseMatrixCompRow mY;
 
-        /// Jacobian matrix
-        CPS::Matrix mJ;
+        /// Jacobian matrix, its sparsity pattern is fixed after the first assembly
+        CPS::SparseMatrix mJ;
+        /// LU factorization of the Jacobian matrix reusing the symbolic analysis
+        CPS::LUFactorizedSparse mJLU;
+        /// Flag whether the sparsity pattern of the Jacobian has been analyzed
+        CPS::Bool mJPatternAnalyzed = false;
         /// Solution vector
         CPS::Vector mX;
 	    /// Vector of mismatch values
@@ -15,18 +15,64 @@
 #include <dpsim/Config.h>
 #include <dpsim/Simulation.h>
 #include <dpsim/Timer.h>
+#include <dpsim/TimingStatistics.h>
 
 namespace DPsim {
 	/// Extending Simulation class by real-time functionality.
 	class RealTimeSimulation : public Simulation {
 
+	public:
+		/// Settings hardening the execution of the real-time loop
+		struct RealTimeProfile {
+			/// SCHED_FIFO priority of the simulation thread, 0 keeps the current policy
+			Int priority = 80;
+			/// CPU the simulation thread is pinned to, -1 to not pin it
+			Int cpu = -1;
+			/// CPUs of the interface threads, interface i uses interfaceCpus[i % size]
+			std::vector<Int> interfaceCpus;
+			/// Lock all current and future pages into memory
+			Bool lockMemory = true;
+			/// Bytes of stack touched before the start
+			std::size_t prefaultStack = 512 * 1024;
+			/// Bytes of heap touched and kept by the allocator before the start
+			std::size_t prefaultHeap = 64 * 1024 * 1024;
+			/// Touch the solver data of a step before the start time
+			Bool warmUp = true;
+		};
+
 	protected:
 		Timer mTimer;
+		RealTimeProfile mProfile;
+		Bool mUseProfile = false;
+
+		/// Applies scheduling policy, affinity and memory settings to the simulation thread
+		void applyProfile();
+		/// Records wake-up latency, compute time and slack of a step
+		void updateTimingStatistics(Timer::IntervalTimePoint wakeUp, Timer::IntervalTimePoint end);
 
 	public:
+		/// Number of ticks missed because a step took too long
+		const CPS::Attribute<Int>::Ptr mOverruns;
+		/// Delay between the timer tick and the start of the last step in seconds
+		const CPS::Attribute<Real>::Ptr mWakeUpLatency;
+		/// Computation time of the last step in seconds
+		const CPS::Attribute<Real>::Ptr mComputeTime;
+		/// Time left between the end of the last step and the next tick in seconds, negative on overruns
+		const CPS::Attribute<Real>::Ptr mSlack;
+		/// Histograms of the values above over all steps
+		const CPS::Attribute<TimingStatistics>::Ptr mWakeUpLatencyStatistics;
+		const CPS::Attribute<TimingStatistics>::Ptr mComputeTimeStatistics;
+		const CPS::Attribute<TimingStatistics>::Ptr mSlackStatistics;
+
 		/// Standard constructor
 		RealTimeSimulation(String name, CPS::Logger::Level logLevel = CPS::Logger::Level::info);
 
+		/// Run with SCHED_FIFO priority, pinned threads, locked and prefaulted memory and a warm-up step
+		void setRealTimeProfile(const RealTimeProfile& profile) {
+			mProfile = profile;
+			mUseProfile = true;
+		}
+
 		/** Perform the main simulation loop in real time.
 		 *
 		 * @param startSynch If true, the simulation waits for the first external value before starting the timing.
@@ -11,6 +11,7 @@
 #include <dpsim-models/Task.h>
 
 #include <dpsim/Definitions.h>
+#include <dpsim/TimingStatistics.h>
 #include <dpsim-models/Logger.h>
 
 #include <atomic>
@@ -18,12 +19,73 @@
 #include <condition_variable>
 #include <deque>
 #include <mutex>
+#include <thread>
 #include <unordered_map>
 
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+  #include <immintrin.h>
+#endif
+
 namespace DPsim {
 	// TODO extend / subclass
 	class SchedulingException {};
 
+	/// Size of a cache line, used to keep atomics written by different threads apart
+	constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+	/// How threads wait for each other. A waiting thread first polls
+	/// spinCount times, then pauseCount times with a pause instruction in
+	/// between, and afterwards either keeps pausing or, if park is set,
+	/// sleeps in the kernel (futex on Linux) until it is woken up.
+	struct WaitPolicy {
+		UInt spinCount = 64;
+		UInt pauseCount = 4096;
+		Bool park = false;
+	};
+
+	/// Hint to the CPU that the thread is busy waiting
+	inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+		_mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+		asm volatile("yield");
+#else
+		std::this_thread::yield();
+#endif
+	}
+
+	/// Sleeps as long as word equals value. Spurious returns are possible.
+	void parkThread(std::atomic<Int>& word, Int value);
+	/// Wakes all threads parked on word
+	void unparkThreads(std::atomic<Int>& word);
+
+	/// Waits according to policy until isDone returns true. Threads parked
+	/// on word are counted in parked, which the thread changing word has to
+	/// check to wake them with unparkThreads.
+	template <typename Condition>
+	void waitFor(std::atomic<Int>& word, std::atomic<Int>& parked, const WaitPolicy& policy, Condition isDone) {
+		for (UInt i = 0; i < policy.spinCount; i++) {
+			if (isDone())
+				return;
+		}
+		for (UInt i = 0; i < policy.pauseCount; i++) {
+			if (isDone())
+				return;
+			cpuRelax();
+		}
+		while (!isDone()) {
+			if (!policy.park) {
+				cpuRelax();
+				continue;
+			}
+			parked.fetch_add(1, std::memory_order_seq_cst);
+			Int value = word.load(std::memory_order_seq_cst);
+			if (!isDone())
+				parkThread(word, value);
+			parked.fetch_sub(1, std::memory_order_seq_cst);
+		}
+	}
+
 	class Scheduler {
 	public:
 		/// Edges describe the dependency from the first task to a list of other tasks
@@ -52,6 +114,11 @@ namespace DPsim {
 		/// Called on simulation stop to reliably clean up e.g. running helper threads
 		virtual void stop() {}
 
+		/// Restrict the calling thread to a single CPU. Returns false if this is not supported.
+		static Bool pinCurrentThread(Int cpu);
+		/// Restrict a thread to a single CPU. Returns false if this is not supported.
+		static Bool pinThread(std::thread& thread, Int cpu);
+
 		/// Helper function that resolves the task-attribute dependencies to task-task dependencies
 		/// and inserts a root task
 		void resolveDeps(CPS::Task::List& tasks, Edges& inEdges, Edges& outEdges);
@@ -65,6 +132,8 @@ namespace DPsim {
 		TaskTime getAveragedMeasurement(CPS::Task::Ptr task) {
 			return getAveragedMeasurement(task.get());
 		}
+		/// Execution time statistics of a measured task, empty if the task is not measured
+		TimingStatistics getMeasurementStatistics(CPS::Task::Ptr task);
 
 		/// Root task that has a dependency on the external attribute
 		/// which means that it should not be removed from the task graph
@@ -87,9 +156,16 @@ namespace DPsim {
 		static void levelSchedule(const CPS::Task::List& tasks, const Edges& inEdges, const Edges& outEdges, std::vector<CPS::Task::List>& levels);
 
 		void initMeasurements(const CPS::Task::List& tasks);
+		/// Index of the task's statistics, which are added if the task is not
+		/// measured yet. Not thread-safe, call it while creating the schedule.
+		UInt measurementIndex(CPS::Task* task);
 		/// Not thread-safe for multiple calls with same task, but should only
 		/// be called once for each task in each step anyway
 		void updateMeasurement(CPS::Task* task, TaskTime time);
+		/// Same as above without the lookup, using the index from measurementIndex
+		void updateMeasurement(UInt index, TaskTime time) {
+			mMeasurements[index].add(time);
+		}
 		/// Write measurement data to file
 		void writeMeasurements(CPS::String filename);
 		/// Read measurement data from file to use it for the scheduling
@@ -104,10 +180,11 @@ namespace DPsim {
 		/// Logger
 		CPS::Logger::Log mSLog;
 	private:
-		// TODO more sophisticated measurement method might be necessary for
-		// longer simulations (risk of high memory requirements and integer
-		// overflow)
-		std::unordered_map<CPS::Task*, std::vector<TaskTime>> mMeasurements;
+		/// Fixed-size execution time statistics, indexed by measurement index
+		std::vector<TimingStatistics> mMeasurements;
+		/// Measured tasks, indexed by measurement index
+		std::vector<CPS::Task*> mMeasuredTasks;
+		std::unordered_map<CPS::Task*, UInt> mMeasurementIndices;
 	};
 
 	/// A barrier is used to synchronize threads. Threads running into the barrier
@@ -120,7 +197,10 @@ namespace DPsim {
 		/// Limit sets the number of threads that need to reach the barrier
 		/// to release it.
 		Barrier(Int limit, Bool useCondition = false) :
-			mLimit(limit), mCount(0), mGeneration(0), mUseCondition(useCondition) {}
+			mLimit(limit), mCount(0), mGeneration(0), mParked(0), mUseCondition(useCondition) {}
+
+		/// Set how threads wait if no condition variable is used
+		void setWaitPolicy(const WaitPolicy& policy) { mPolicy = policy; }
 
 		/// Blocks until |limit| calls have been made, at which point all threads
 		/// return. Provides synchronization, i.e. all writes from before this call
@@ -148,9 +228,11 @@ namespace DPsim {
 				// (This generates the same code on x86.)
 				if (mCount.fetch_add(1, std::memory_order_acq_rel) == mLimit-1) {
 					mCount.store(0, std::memory_order_relaxed);
-					mGeneration.fetch_add(1, std::memory_order_release);
+					release();
 				} else {
-					while (mGeneration.load(std::memory_order_acquire) == gen);
+					waitFor(mGeneration, mParked, mPolicy, [this, gen]() {
+						return mGeneration.load(std::memory_order_acquire) != gen;
+					});
 				}
 			}
 		}
@@ -173,19 +255,30 @@ namespace DPsim {
 				// No release here, as this call does not provide any synchronization anyway.
 				if (mCount.fetch_add(1, std::memory_order_acquire) == mLimit-1) {
 					mCount.store(0, std::memory_order_relaxed);
-					mGeneration.fetch_add(1, std::memory_order_release);
+					release();
 				}
 			}
 		}
 
 	private:
+		/// Starts the next generation and wakes parked threads. The stores are
+		/// sequentially consistent so that they cannot miss a thread parking.
+		void release() {
+			mGeneration.fetch_add(1, std::memory_order_seq_cst);
+			if (mParked.load(std::memory_order_seq_cst) > 0)
+				unparkThreads(mGeneration);
+		}
+
 		/// Barrier limit which has to be reached before the barrier is released.
 		Int mLimit;
 		/// Barrier counter which is tested against limit
-		std::atomic<Int> mCount;
+		alignas(CACHE_LINE_SIZE) std::atomic<Int> mCount;
 		/// Allows multiple use of the barrier
-		std::atomic<Int> mGeneration;
+		alignas(CACHE_LINE_SIZE) std::atomic<Int> mGeneration;
+		/// Number of threads parked on mGeneration
+		std::atomic<Int> mParked;
 		Bool mUseCondition;
+		WaitPolicy mPolicy;
 
 		std::mutex mMutex;
 		std::condition_variable mCondition;
@@ -201,19 +294,30 @@ namespace DPsim {
 		std::vector<Barrier*> mBarriers;
 	};
 
-	class Counter {
+	/// Counter that other threads can wait on. It occupies a cache line of
+	/// its own so that counters of different tasks do not share one.
+	class alignas(CACHE_LINE_SIZE) Counter {
 	public:
-		Counter() : mValue(0) {}
+		Counter() : mValue(0), mParked(0) {}
 
 		void inc() {
-			mValue.fetch_add(1, std::memory_order_release);
+			// Sequentially consistent so that it cannot miss a thread parking
+			mValue.fetch_add(1, std::memory_order_seq_cst);
+			if (mParked.load(std::memory_order_seq_cst) > 0)
+				unparkThreads(mValue);
 		}
 
-		void wait(Int value) {
-			while (mValue.load(std::memory_order_acquire) != value);
+		void wait(Int value, const WaitPolicy& policy = WaitPolicy()) {
+			if (mValue.load(std::memory_order_acquire) == value)
+				return;
+			waitFor(mValue, mParked, policy, [this, value]() {
+				return mValue.load(std::memory_order_acquire) == value;
+			});
 		}
 
 	private:
 		std::atomic<Int> mValue;
+		/// Number of threads parked on mValue
+		std::atomic<Int> mParked;
 	};
 }
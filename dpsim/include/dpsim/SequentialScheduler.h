@@ -29,6 +29,8 @@ namespace DPsim {
 
 	private:
 		CPS::Task::List mSchedule;
+		/// Measurement index of each scheduled task
+		std::vector<UInt> mScheduleMeasurements;
 
 		std::unordered_map<size_t, std::vector<std::chrono::nanoseconds>> mMeasurements;
 		std::vector<std::chrono::nanoseconds> mStepMeasurements;
@@ -9,6 +9,7 @@
 #include <dpsim/DataLogger.h>
 #include <dpsim/Solver.h>
 #include <dpsim/Scheduler.h>
+#include <dpsim/TimingStatistics.h>
 #include <dpsim/Event.h>
 #include <dpsim-models/Definitions.h>
 #include <dpsim-models/Logger.h>
@@ -77,6 +78,10 @@ namespace DPsim {
 		CPS::Logger::Level mLogLevel;
 		/// (Real) time needed for the timesteps
 		std::vector<Real> mStepTimes;
+		/// Keep every step time in mStepTimes, which grows with the simulation length
+		Bool mRecordStepTimes = false;
+		/// Fixed-size statistics of the step times, always updated
+		TimingStatistics mStepTimeStatistics;
 
 		// #### Solver Settings ####
 		///
@@ -93,10 +98,29 @@ namespace DPsim {
 		Bool mInitFromNodesAndTerminals = true;
 		/// Enable recomputation of system matrix during simulation
 		Bool mSystemMatrixRecomputation = false;
+		/// Factorize switch configurations on first use instead of precomputing all of them
+		Bool mLazySwitchFactorization = false;
+		/// Memory limit in bytes for cached switch configurations (zero means unlimited)
+		std::size_t mSwitchFactorizationCacheLimit = 0;
+		/// Apply changes of the recomputed system matrix as low-rank updates of its last factorization
+		Bool mLowRankUpdates = false;
+		/// Maximum rank of a low-rank update before the system matrix is refactorized
+		UInt mLowRankUpdateMaxRank = 10;
+		/// Solve the recomputed system through the Schur complement of the variable elements' nodes
+		Bool mSchurComplementUpdates = false;
+		/// Further scenarios of the system that are simulated in lockstep
+		std::vector<CPS::SystemTopology> mEnsemble;
 
 		/// If tearing components exist, the Diakoptics
 		/// solver is selected automatically.
 		CPS::IdentifiedObject::List mTearComponents = CPS::IdentifiedObject::List();
+		/// Split the system with the DiakopticsPartitioner if no tearing
+		/// components are given
+		Bool mAutomaticTearing = false;
+		/// Number of subnets of automatic tearing, zero for one per thread
+		UInt mAutomaticTearingSubnets = 0;
+		/// Number of threads the automatically torn subnets are balanced for
+		UInt mAutomaticTearingThreads = 1;
 		/// Determines if the system matrix is split into
 		/// several smaller matrices, one for each frequency.
 		/// This can only be done if the network is composed
@@ -132,6 +156,12 @@ namespace DPsim {
 
 		/// The data loggers
 		DataLogger::List mLoggers;
+		/// Write logs from writer threads
+		Bool mAsyncLogging = false;
+		/// Number of rows buffered by each asynchronous logger
+		UInt mLogBufferRows = 4096;
+		/// Behaviour of asynchronous loggers when their buffer is full
+		DataLogger::FullBufferPolicy mLogFullBufferPolicy = DataLogger::FullBufferPolicy::Block;
 
 		/// Helper function for constructors
 		void create();
@@ -141,6 +171,12 @@ namespace DPsim {
 		/// Subroutine for MNA only because there are many MNA options
 		template <typename VarType>
 		void createMNASolver();
+		/// Creates an MNA solver from the factory with the simulation settings
+		template <typename VarType>
+		std::shared_ptr<MnaSolver<VarType>> createMNASolverImpl(String name, const CPS::SystemTopology& system);
+		/// Creates the solvers of the system and its ensemble scenarios
+		template <typename VarType>
+		void createEnsembleMNASolver();
 		/// Prepare schedule for simulation
 		void prepSchedule();
 
@@ -180,6 +216,14 @@ namespace DPsim {
 		void setTearingComponents(CPS::IdentifiedObject::List tearComponents = CPS::IdentifiedObject::List()) {
 			mTearComponents = tearComponents;
 		}
+		/// Select the tearing components automatically, splitting the system
+		/// into the given number of subnets, or one per thread if subnets is
+		/// zero, balanced for the given number of threads
+		void setAutomaticTearing(UInt subnets, UInt threads = 1) {
+			mAutomaticTearing = true;
+			mAutomaticTearingSubnets = subnets;
+			mAutomaticTearingThreads = threads;
+		}
 		/// Set the scheduling method
 		void setScheduler(const std::shared_ptr<Scheduler> &scheduler) {
 			mScheduler = scheduler;
@@ -188,6 +232,26 @@ namespace DPsim {
 		void doFrequencyParallelization(Bool value) { mFreqParallel = value; }
 		///
 		void doSystemMatrixRecomputation(Bool value) { mSystemMatrixRecomputation = value; }
+		/// Factorize switch configurations on first use and keep them in a
+		/// least recently used cache. Only supported by the EigenSparse solver.
+		void doLazySwitchFactorization(Bool value) { mLazySwitchFactorization = value; }
+		/// Memory limit in bytes for the cache of lazily factorized switch configurations
+		void setSwitchFactorizationCacheLimit(std::size_t bytes) { mSwitchFactorizationCacheLimit = bytes; }
+		/// Handle system matrix changes during recomputation by a Woodbury update of the
+		/// last factorization instead of refactorizing. Only supported by the EigenSparse solver.
+		void doLowRankUpdates(Bool value) { mLowRankUpdates = value; }
+		/// Number of changed matrix columns above which the system matrix is refactorized
+		void setLowRankUpdateMaxRank(UInt rank) { mLowRankUpdateMaxRank = rank; }
+		/// During recomputation, factorize the static network once and only refactorize the
+		/// small Schur complement of the nodes of switches and variable elements when they
+		/// change. Takes precedence over low-rank updates. Only supported by the EigenSparse solver.
+		void doSchurComplementUpdates(Bool value) { mSchurComplementUpdates = value; }
+		/// Simulate further scenarios of the system in lockstep. The scenarios
+		/// must have the same system matrix as the system, e.g. differ only in
+		/// source profiles or load setpoints, so each step solves the right side
+		/// vectors of all scenarios with one factorization. Only supported by
+		/// the sparse solvers without recomputation or parallel frequencies.
+		void setEnsemble(const std::vector<CPS::SystemTopology>& scenarios) { mEnsemble = scenarios; }
 
 		// #### Initialization ####
 		/// activate steady state initialization
@@ -223,7 +287,19 @@ namespace DPsim {
 		void addLogger(DataLogger::Ptr logger) {
 			mLoggers.push_back(logger);
 		}
-		/// Write step time measurements to log file
+		/// Move the file output of all data loggers, including those of the
+		/// solvers, to writer threads so that logging does not block a step
+		void doAsyncLogging(Bool value, UInt bufferRows = 4096,
+			DataLogger::FullBufferPolicy policy = DataLogger::FullBufferPolicy::Block) {
+			mAsyncLogging = value;
+			mLogBufferRows = bufferRows;
+			mLogFullBufferPolicy = policy;
+		}
+		/// Keep all step times in stepTimes(). Disabled by default, so that only
+		/// the fixed-size stepTimeStatistics() are updated and long runs use
+		/// bounded memory.
+		void doStepTimeRecording(Bool value) { mRecordStepTimes = value; }
+		/// Write the step times kept by doStepTimeRecording to log file
 		void logStepTimes(String logName);
 
 		///
@@ -246,6 +322,7 @@ namespace DPsim {
 		DataLogger::List& loggers() { return mLoggers; }
 		std::shared_ptr<Scheduler> scheduler() { return mScheduler; }
 		std::vector<Real>& stepTimes() { return mStepTimes; }
+		const TimingStatistics& stepTimeStatistics() const { return mStepTimeStatistics; }
 
 		// #### Set component attributes during simulation ####
 		/// CHECK: Can these be deleted? getIdObjAttribute + "**attr =" should suffice
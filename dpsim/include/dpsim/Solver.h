@@ -14,6 +14,7 @@
 
 #include <dpsim/Definitions.h>
 #include <dpsim/Config.h>
+#include <dpsim/DataLogger.h>
 #include <dpsim-models/Logger.h>
 #include <dpsim-models/SystemTopology.h>
 #include <dpsim-models/Task.h>
@@ -59,6 +60,17 @@ namespace DPsim {
 		Bool mInitFromNodesAndTerminals = true;
 		/// Enable recomputation of system matrix during simulation
 		Bool mSystemMatrixRecomputation = false;
+		/// Factorize switch configurations on first use instead of precomputing all of them
+		Bool mLazySwitchFactorization = false;
+		/// Memory limit in bytes for cached switch configurations (zero means unlimited)
+		std::size_t mSwitchFactorizationCacheLimit = 0;
+		/// Apply changes of the recomputed system matrix as low-rank updates of its last factorization
+		Bool mLowRankUpdates = false;
+		/// Maximum rank of a low-rank update before the system matrix is refactorized
+		UInt mLowRankUpdateMaxRank = 10;
+		/// Factorize the static network once and only refactorize the Schur complement
+		/// of the nodes of switches and variable elements when the system matrix changes
+		Bool mSchurComplementUpdates = false;
 
 		/// Solver behaviour initialization or simulation
         Behaviour mBehaviour = Solver::Behaviour::Simulation;
@@ -89,6 +101,16 @@ namespace DPsim {
 		virtual void setSystem(const CPS::SystemTopology &system) {}
 		///
 		void doSystemMatrixRecomputation(Bool value) { mSystemMatrixRecomputation = value; }
+		///
+		void doLazySwitchFactorization(Bool value) { mLazySwitchFactorization = value; }
+		///
+		void setSwitchFactorizationCacheLimit(std::size_t bytes) { mSwitchFactorizationCacheLimit = bytes; }
+		///
+		void doLowRankUpdates(Bool value) { mLowRankUpdates = value; }
+		///
+		void setLowRankUpdateMaxRank(UInt rank) { mLowRankUpdateMaxRank = rank; }
+		///
+		void doSchurComplementUpdates(Bool value) { mSchurComplementUpdates = value; }
 
 		// #### Initialization ####
 		///
@@ -109,5 +131,10 @@ namespace DPsim {
 		virtual CPS::Task::List getTasks() = 0;
 		/// Log results
 		virtual void log(Real time, Int timeStepCount) { };
+		/// Data loggers written by the solver itself
+		virtual DataLogger::List loggers() { return DataLogger::List(); }
+		/// Touches the data of a step without changing the solver state,
+		/// so that its first step does not run on cold caches
+		virtual void warmUp() { }
 	};
 }
@@ -22,6 +22,17 @@ namespace DPsim {
 		void step(Real time, Int timeStepCount);
 		virtual void stop();
 
+		/// Set how threads wait for their predecessors and the start of a step
+		void setWaitPolicy(const WaitPolicy& policy);
+		/// Pin worker thread i (1 <= i < threads) to cpus[(i-1) % cpus.size()].
+		/// The simulation thread, which runs the tasks of thread 0, is not touched.
+		/// Has to be called before the schedule is created.
+		void setThreadAffinity(const std::vector<Int>& cpus) { mThreadAffinity = cpus; }
+		/// Record how long each thread waits for tasks on other threads in every step
+		void measureWaitTimes(Bool value = true) { mMeasureWaitTimes = value; }
+		/// Per-step wait time statistics of a thread
+		const TimingStatistics& waitTimeStatistics(Int thread) const { return mWaitTimes[thread]; }
+
 	protected:
 		void finishSchedule(const Edges& inEdges);
 		void scheduleTask(int thread, CPS::Task::Ptr task);
@@ -29,22 +40,31 @@ namespace DPsim {
 		Int mNumThreads;
 
 	private:
-		void doStep(Int scheduleIdx);
+		/// Runs the tasks of one thread and returns how long it waited for other threads
+		TaskTime doStep(Int scheduleIdx);
 		static void threadFunction(ThreadScheduler* sched, Int idx);
 
 		String mOutMeasurementFile;
 		Barrier mStartBarrier;
+		WaitPolicy mWaitPolicy;
+		std::vector<Int> mThreadAffinity;
+		Bool mMeasureWaitTimes = false;
+		std::vector<TimingStatistics> mWaitTimes;
 
 		std::vector<std::thread> mThreads;
 
 		std::vector<CPS::Task::List> mTempSchedules;
+		/// Padded to cache lines by endCounter, which is polled by other threads
 		struct ScheduleEntry {
 			CPS::Task* task;
+			UInt measurementIdx;
 			Counter endCounter;
 			std::vector<Counter*> reqCounters;
 		};
 		std::vector<ScheduleEntry*> mSchedules;
 
+		void waitForPredecessors(ScheduleEntry* entry, TaskTime& waitTime);
+
 		Bool mJoining = false;
 		Real mTime = 0;
 		Int mTimeStepCount = 0;
@@ -35,6 +35,7 @@ namespace DPsim {
 		} mState;
 
 		StartTimePoint mStartAt;
+		IntervalTimePoint mStartTick;
 		IntervalTimePoint mNextTick;
 		Ticks mTickInterval;
 
@@ -74,6 +75,15 @@ namespace DPsim {
 			return mTicks;
 		}
 
+		/// Time of the tick the last call to sleep() waited for
+		IntervalTimePoint lastTick() {
+#ifdef HAVE_TIMERFD
+			return mStartTick + (mTicks - 1) * mTickInterval;
+#else
+			return mNextTick - mTickInterval;
+#endif
+		}
+
 		Ticks interval() {
 			return mTickInterval;
 		}
@@ -0,0 +1,98 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+#include <dpsim/Definitions.h>
+
+namespace DPsim {
+
+	/// Fixed-size streaming statistics of a series of durations.
+	///
+	/// Keeps count, minimum, maximum, mean and variance (Welford) and a
+	/// log-bucketed histogram with eight linear sub-buckets per power of two,
+	/// so quantiles are resolved to within 12.5 %. Adding a sample neither
+	/// allocates nor depends on the number of samples seen so far.
+	class TimingStatistics {
+	public:
+		using Duration = std::chrono::nanoseconds;
+
+		/// Linear sub-buckets per power of two
+		static constexpr UInt SUB_BUCKETS = 8;
+		/// Buckets needed to cover all non-negative 64 bit durations
+		static constexpr UInt NUM_BUCKETS = SUB_BUCKETS * 62;
+
+		TimingStatistics() { reset(); }
+
+		void reset();
+
+		void add(Duration time) {
+			int64_t value = time.count() > 0 ? time.count() : 0;
+			if (mCount == 0 || value < mMin)
+				mMin = value;
+			if (mCount == 0 || value > mMax)
+				mMax = value;
+
+			++mCount;
+			mSum += value;
+			Real delta = static_cast<Real>(value) - mMean;
+			mMean += delta / static_cast<Real>(mCount);
+			mM2 += delta * (static_cast<Real>(value) - mMean);
+
+			++mBuckets[bucket(static_cast<uint64_t>(value))];
+		}
+
+		uint64_t count() const { return mCount; }
+		Duration min() const { return Duration(mMin); }
+		Duration max() const { return Duration(mMax); }
+		/// Mean rounded down to whole ticks, as the former sample average
+		Duration mean() const { return Duration(mCount ? mSum / static_cast<int64_t>(mCount) : 0); }
+		/// Sample standard deviation in nanoseconds
+		Real stddev() const;
+		/// Approximate q-quantile (0 <= q <= 1) taken from the histogram
+		Duration quantile(Real q) const;
+
+	private:
+		uint64_t mCount;
+		int64_t mMin;
+		int64_t mMax;
+		int64_t mSum;
+		Real mMean;
+		Real mM2;
+		std::array<uint64_t, NUM_BUCKETS> mBuckets;
+
+		static UInt bucket(uint64_t value) {
+			if (value < SUB_BUCKETS)
+				return static_cast<UInt>(value);
+			UInt exponent = log2(value);
+			return SUB_BUCKETS * (exponent - 2) + static_cast<UInt>((value >> (exponent - 3)) - SUB_BUCKETS);
+		}
+
+		static UInt log2(uint64_t value) {
+#if defined(__GNUC__)
+			return 63 - static_cast<UInt>(__builtin_clzll(value));
+#else
+			UInt exponent = 0;
+			while (value >>= 1)
+				++exponent;
+			return exponent;
+#endif
+		}
+
+		/// Midpoint of the durations falling into a bucket
+		static Real bucketValue(UInt bucket);
+	};
+
+	/// Prints a summary in nanoseconds, used by attributes holding statistics
+	std::ostream& operator<<(std::ostream& os, const TimingStatistics& stats);
+}
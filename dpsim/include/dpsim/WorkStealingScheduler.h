@@ -0,0 +1,108 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <dpsim/Scheduler.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace DPsim {
+	/// Scheduler executing the task graph dynamically instead of following
+	/// fixed per-thread lists. Every thread owns a deque of ready tasks, runs
+	/// the newest one itself and steals the oldest from other threads when its
+	/// own deque is empty. A task becomes ready once all of its predecessors
+	/// have finished in the current step, so a slow task only delays its
+	/// successors and not the other tasks assigned to the same thread.
+	/// All per-step state is allocated in createSchedule.
+	class WorkStealingScheduler : public Scheduler {
+	public:
+		WorkStealingScheduler(Int threads = 1, String outMeasurementFile = String());
+		virtual ~WorkStealingScheduler();
+
+		void createSchedule(const CPS::Task::List& tasks, const Edges& inEdges, const Edges& outEdges);
+		void step(Real time, Int timeStepCount);
+		void stop();
+
+		/// Set how threads wait at the start and end of a step and while
+		/// they look for work
+		void setWaitPolicy(const WaitPolicy& policy);
+		/// Pin worker thread i (1 <= i < threads) to cpus[(i-1) % cpus.size()].
+		/// Has to be called before the schedule is created.
+		void setThreadAffinity(const std::vector<Int>& cpus) { mThreadAffinity = cpus; }
+
+	private:
+		/// Ready tasks of one thread. Each task is pushed at most once per
+		/// step, so the array holding all tasks never wraps around.
+		struct alignas(CACHE_LINE_SIZE) TaskDeque {
+			std::unique_ptr<UInt[]> tasks;
+			UInt head = 0;
+			UInt tail = 0;
+			std::atomic_flag lock = ATOMIC_FLAG_INIT;
+
+			void acquire() {
+				while (lock.test_and_set(std::memory_order_acquire))
+					cpuRelax();
+			}
+			void release() {
+				lock.clear(std::memory_order_release);
+			}
+			/// Called by the owning thread
+			void push(UInt task);
+			/// Takes the newest task, called by the owning thread
+			Bool pop(UInt& task);
+			/// Takes the oldest task, called by other threads
+			Bool steal(UInt& task);
+		};
+
+		void doStep(Int thread);
+		/// Takes a task from the own deque or steals one from another thread
+		Bool takeTask(Int thread, UInt& task);
+		void executeTask(Int thread, UInt task);
+		/// Wakes threads parked while looking for work
+		void signalWork();
+		static void threadFunction(WorkStealingScheduler* sched, Int idx);
+
+		Int mNumThreads;
+		String mOutMeasurementFile;
+		Barrier mStartBarrier;
+		Barrier mEndBarrier;
+		std::vector<std::thread> mThreads;
+		std::vector<Int> mThreadAffinity;
+		Bool mJoining = false;
+
+		/// Scheduled tasks in topological order
+		std::vector<CPS::Task*> mTasks;
+		/// Measurement index of each task
+		std::vector<UInt> mTaskMeasurements;
+		/// Successors of task i are mSuccessors[mSuccessorOffsets[i]] to mSuccessors[mSuccessorOffsets[i+1]-1]
+		std::vector<UInt> mSuccessorOffsets;
+		std::vector<UInt> mSuccessors;
+		/// Number of predecessors of each task
+		std::vector<Int> mNumPredecessors;
+		/// Tasks without predecessors
+		std::vector<UInt> mRootTasks;
+
+		/// Predecessors of each task that have not finished in the current step
+		std::unique_ptr<std::atomic<Int>[]> mPendingPredecessors;
+		/// Tasks that have not finished in the current step
+		alignas(CACHE_LINE_SIZE) std::atomic<Int> mRemainingTasks;
+		/// Changed when tasks become ready or the step ends if threads may park
+		alignas(CACHE_LINE_SIZE) std::atomic<Int> mWorkSignal;
+		/// Number of threads parked on mWorkSignal
+		std::atomic<Int> mWorkParked;
+		WaitPolicy mWaitPolicy;
+		std::unique_ptr<TaskDeque[]> mDeques;
+
+		Real mTime = 0;
+		Int mTimeStepCount = 0;
+	};
+}
@@ -0,0 +1,118 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/BinaryDataLogger.h>
+#include <dpsim-models/Logger.h>
+
+using namespace DPsim;
+
+static const char BINARY_LOG_MAGIC[8] = { 'D', 'P', 'S', 'I', 'M', 'L', 'O', 'G' };
+static const uint32_t BINARY_LOG_VERSION = 1;
+
+BinaryDataLogger::BinaryDataLogger(String name, Bool enabled, UInt downsampling, UInt blockRows) :
+	DataLogger(enabled),
+	mBlockRows(blockRows > 0 ? blockRows : 1) {
+	mName = name;
+	mDownsampling = downsampling;
+	if (!mEnabled)
+		return;
+
+	mFilename = CPS::Logger::logDir() + "/" + name + ".bin";
+
+	if (mFilename.has_parent_path() && !fs::exists(mFilename.parent_path()))
+		fs::create_directory(mFilename.parent_path());
+
+	open();
+}
+
+BinaryDataLogger::~BinaryDataLogger() {
+	close();
+}
+
+void BinaryDataLogger::open() {
+	mLogFile = std::ofstream(mFilename, std::ios_base::out|std::ios_base::trunc|std::ios_base::binary);
+	if (!mLogFile.is_open())
+		throw CPS::SystemError("Cannot open log file " + mFilename.string());
+	mColumns.clear();
+	mNumRows = 0;
+}
+
+void BinaryDataLogger::close() {
+	stopWriter();
+	if (mLogFile.is_open() && mNumRows > 0)
+		writeBlock();
+	mLogFile.close();
+}
+
+void BinaryDataLogger::writeHeader() {
+	// Resolve the attributes once, the map order defines the column order
+	if (!resolveColumns())
+		throw CPS::SystemError("Logger " + mName + " has attributes that are not numbers and cannot be written to a binary log");
+
+	mTimes.assign(mBlockRows, 0);
+	mValues.assign(mColumns.size() * mBlockRows, 0);
+	mNumRows = 0;
+
+	uint32_t numColumns = static_cast<uint32_t>(mColumns.size());
+	mLogFile.write(BINARY_LOG_MAGIC, sizeof(BINARY_LOG_MAGIC));
+	mLogFile.write(reinterpret_cast<const char*>(&BINARY_LOG_VERSION), sizeof(BINARY_LOG_VERSION));
+	mLogFile.write(reinterpret_cast<const char*>(&numColumns), sizeof(numColumns));
+
+	UInt col = 0;
+	for (auto& it : mAttributes) {
+		uint8_t type = static_cast<uint8_t>(mColumns[col++].type);
+		uint32_t nameLength = static_cast<uint32_t>(it.first.size());
+		mLogFile.write(reinterpret_cast<const char*>(&type), sizeof(type));
+		mLogFile.write(reinterpret_cast<const char*>(&nameLength), sizeof(nameLength));
+		mLogFile.write(it.first.data(), nameLength);
+	}
+}
+
+void BinaryDataLogger::writeBlock() {
+	uint32_t numRows = static_cast<uint32_t>(mNumRows);
+	mLogFile.write(reinterpret_cast<const char*>(&numRows), sizeof(numRows));
+	mLogFile.write(reinterpret_cast<const char*>(mTimes.data()), mNumRows * sizeof(Real));
+	for (UInt col = 0; col < mColumns.size(); ++col)
+		mLogFile.write(reinterpret_cast<const char*>(&mValues[col * mBlockRows]), mNumRows * sizeof(Real));
+	mNumRows = 0;
+}
+
+void BinaryDataLogger::log(Real time, Int timeStepCount) {
+	if (!mEnabled || !(timeStepCount % mDownsampling == 0))
+		return;
+
+	if (mAsync) {
+		if (!mWriterThread.joinable()) {
+			writeHeader();
+			startWriter(static_cast<UInt>(mColumns.size()), true);
+		}
+		if (Real* row = beginRow(time)) {
+			readColumns(row, 1);
+			commitRow();
+		}
+		return;
+	}
+
+	if (mLogFile.tellp() == std::ofstream::pos_type(0))
+		writeHeader();
+
+	mTimes[mNumRows] = time;
+	readColumns(mValues.data() + mNumRows, mBlockRows);
+
+	if (++mNumRows == mBlockRows)
+		writeBlock();
+}
+
+void BinaryDataLogger::writeRow(Real time, const Real* values) {
+	mTimes[mNumRows] = time;
+	for (UInt col = 0; col < mColumns.size(); ++col)
+		mValues[col * mBlockRows + mNumRows] = values[col];
+
+	if (++mNumRows == mBlockRows)
+		writeBlock();
+}
@@ -7,6 +7,7 @@
  *********************************************************************************/
 
 #include <iomanip>
+#include <chrono>
 
 #include <dpsim/DataLogger.h>
 #include <dpsim-models/Logger.h>
@@ -16,14 +17,16 @@ using namespace DPsim;
 DataLogger::DataLogger(Bool enabled) :
 	mLogFile(),
 	mEnabled(enabled),
-	mDownsampling(1) {
+	mDownsampling(1),
+	mSLog(CPS::Logger::get("DataLogger", CPS::Logger::Level::warn, CPS::Logger::Level::warn)) {
 	mLogFile.setstate(std::ios_base::badbit);
 }
 
 DataLogger::DataLogger(String name, Bool enabled, UInt downsampling) :
 	mName(name),
 	mEnabled(enabled),
-	mDownsampling(downsampling) {
+	mDownsampling(downsampling),
+	mSLog(CPS::Logger::get("DataLogger", CPS::Logger::Level::warn, CPS::Logger::Level::warn)) {
 	if (!mEnabled)
 		return;
 
@@ -45,9 +48,136 @@ void DataLogger::open() {
 }
 
 void DataLogger::close() {
+	stopWriter();
 	mLogFile.close();
 }
 
+void DataLogger::enableAsync(UInt bufferRows, FullBufferPolicy policy) {
+	mAsync = true;
+	mBufferRows = bufferRows > 0 ? bufferRows : 1;
+	mFullBufferPolicy = policy;
+}
+
+Bool DataLogger::resolveColumns() {
+	mColumns.clear();
+	for (auto& it : mAttributes) {
+		auto attr = it.second.getPtr();
+		if (std::dynamic_pointer_cast<CPS::Attribute<Real>>(attr))
+			mColumns.push_back({ ColumnType::Real, attr.get() });
+		else if (std::dynamic_pointer_cast<CPS::Attribute<Int>>(attr))
+			mColumns.push_back({ ColumnType::Int, attr.get() });
+		else if (std::dynamic_pointer_cast<CPS::Attribute<UInt>>(attr))
+			mColumns.push_back({ ColumnType::UInt, attr.get() });
+		else if (std::dynamic_pointer_cast<CPS::Attribute<Bool>>(attr))
+			mColumns.push_back({ ColumnType::Bool, attr.get() });
+		else
+			return false;
+	}
+	return true;
+}
+
+void DataLogger::readColumns(Real* values, UInt stride) {
+	for (UInt col = 0; col < mColumns.size(); ++col) {
+		const Column& column = mColumns[col];
+		Real& value = values[col * stride];
+		switch (column.type) {
+			case ColumnType::Real: value = static_cast<CPS::Attribute<Real>*>(column.attr)->get(); break;
+			case ColumnType::Int: value = static_cast<CPS::Attribute<Int>*>(column.attr)->get(); break;
+			case ColumnType::UInt: value = static_cast<CPS::Attribute<UInt>*>(column.attr)->get(); break;
+			case ColumnType::Bool: value = static_cast<CPS::Attribute<Bool>*>(column.attr)->get(); break;
+		}
+	}
+}
+
+void DataLogger::startWriter(UInt rowWidth, Bool attributeRows) {
+	mRowWidth = rowWidth;
+	mAttributeRows = attributeRows;
+	mRingTimes.assign(mBufferRows, 0);
+	mRingValues.assign(mBufferRows * mRowWidth, 0);
+	mRingHead = 0;
+	mRingTail = 0;
+	mCrowdedRows = 0;
+
+	mWriterRunning = true;
+	mWriterThread = std::thread(&DataLogger::writeRows, this);
+}
+
+void DataLogger::stopWriter() {
+	if (!mWriterThread.joinable())
+		return;
+
+	mWriterRunning = false;
+	mWriterThread.join();
+
+	if (mDroppedRows > 0)
+		mSLog->warn("Logger {} dropped {} rows", mName, mDroppedRows.load());
+}
+
+void DataLogger::writeRows() {
+	std::size_t tail = mRingTail.load(std::memory_order_relaxed);
+	while (true) {
+		// Read the flag first, so that rows pushed before stopping are still written
+		bool running = mWriterRunning.load(std::memory_order_acquire);
+		std::size_t head = mRingHead.load(std::memory_order_acquire);
+
+		if (tail == head) {
+			if (!running)
+				break;
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			continue;
+		}
+
+		for (; tail != head; ++tail) {
+			std::size_t slot = tail % mBufferRows;
+			writeRow(mRingTimes[slot], &mRingValues[slot * mRowWidth]);
+			mRingTail.store(tail + 1, std::memory_order_release);
+		}
+	}
+	mLogFile.flush();
+}
+
+Real* DataLogger::beginRow(Real time) {
+	std::size_t head = mRingHead.load(std::memory_order_relaxed);
+	std::size_t used = head - mRingTail.load(std::memory_order_acquire);
+
+	if (mFullBufferPolicy == FullBufferPolicy::Downsample && 2 * used >= mBufferRows) {
+		if (mCrowdedRows++ % 2 == 1) {
+			++mDroppedRows;
+			return nullptr;
+		}
+	}
+
+	if (used >= mBufferRows) {
+		if (mFullBufferPolicy != FullBufferPolicy::Block) {
+			++mDroppedRows;
+			return nullptr;
+		}
+		while (head - mRingTail.load(std::memory_order_acquire) >= mBufferRows)
+			std::this_thread::yield();
+	}
+
+	std::size_t slot = head % mBufferRows;
+	mRingTimes[slot] = time;
+	return mRingValues.data() + slot * mRowWidth;
+}
+
+void DataLogger::writeRow(Real time, const Real* values) {
+	mLogFile << std::scientific << std::right << std::setw(14) << time;
+	if (mAttributeRows) {
+		// Same formatting as Attribute::toString
+		for (UInt col = 0; col < mRowWidth; ++col) {
+			if (mColumns[col].type == ColumnType::Real)
+				mLogFile << ", " << std::right << std::setw(13) << std::to_string(values[col]);
+			else
+				mLogFile << ", " << std::right << std::setw(13) << std::to_string(static_cast<long long>(values[col]));
+		}
+	} else {
+		for (UInt col = 0; col < mRowWidth; ++col)
+			mLogFile << ", " << std::right << std::setw(13) << values[col];
+	}
+	mLogFile << '\n';
+}
+
 void DataLogger::setColumnNames(std::vector<String> names) {
 	if (mLogFile.tellp() == std::ofstream::pos_type(0)) {
 		mLogFile << std::right << std::setw(14) << "time";
@@ -71,6 +201,17 @@ void DataLogger::logDataLine(Real time, const Matrix& data) {
 	if (!mEnabled)
 		return;
 
+	if (mAsync) {
+		if (!mWriterThread.joinable())
+			startWriter(static_cast<UInt>(data.rows()), false);
+		if (Real* row = beginRow(time)) {
+			for (Int i = 0; i < data.rows(); ++i)
+				row[i] = data(i, 0);
+			commitRow();
+		}
+		return;
+	}
+
 	mLogFile << std::scientific << std::right << std::setw(14) << time;
 	for (Int i = 0; i < data.rows(); ++i) {
 		mLogFile << ", " << std::right << std::setw(13) << data(i, 0);
@@ -89,7 +230,7 @@ void DataLogger::logDataLine(Real time, const MatrixComp& data) {
 }
 
 void DataLogger::logPhasorNodeValues(Real time, const Matrix& data, Int freqNum) {
-	if (mLogFile.tellp() == std::ofstream::pos_type(0)) {
+	if (!mWriterThread.joinable() && mLogFile.tellp() == std::ofstream::pos_type(0)) {
 		std::vector<String> names;
 
 		Int harmonicOffset = data.rows() / freqNum;
@@ -115,7 +256,7 @@ void DataLogger::logPhasorNodeValues(Real time, const Matrix& data, Int freqNum)
 }
 
 void DataLogger::logEMTNodeValues(Real time, const Matrix& data) {
-	if (mLogFile.tellp() == std::ofstream::pos_type(0)) {
+	if (!mWriterThread.joinable() && mLogFile.tellp() == std::ofstream::pos_type(0)) {
 		std::vector<String> names;
 		for (Int i = 0; i < data.rows(); ++i) {
 			std::stringstream name;
@@ -131,13 +272,31 @@ void DataLogger::log(Real time, Int timeStepCount) {
 	if (!mEnabled || !(timeStepCount % mDownsampling == 0))
 		return;
 
-	if (mLogFile.tellp() == std::ofstream::pos_type(0)) {
+	if (!mWriterThread.joinable() && mLogFile.tellp() == std::ofstream::pos_type(0)) {
 		mLogFile << std::right << std::setw(14) << "time";
 		for (auto it : mAttributes)
 			mLogFile << ", " << std::right << std::setw(13) << it.first;
 		mLogFile << '\n';
 	}
 
+	if (mAsync && !mWriterThread.joinable()) {
+		// Attributes that are not numbers keep the synchronous text output
+		if (resolveColumns()) {
+			startWriter(static_cast<UInt>(mColumns.size()), true);
+		} else {
+			mSLog->warn("Logger {} has attributes that are not numbers, writing synchronously", mName);
+			mAsync = false;
+		}
+	}
+
+	if (mAsync) {
+		if (Real* row = beginRow(time)) {
+			readColumns(row, 1);
+			commitRow();
+		}
+		return;
+	}
+
 	mLogFile << std::scientific << std::right << std::setw(14) << time;
 	for (auto it : mAttributes)
 		mLogFile << ", " << std::right << std::setw(13) << it.second->toString();
@@ -0,0 +1,467 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/DiakopticsPartitioner.h>
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <dpsim-models/SimPowerComp.h>
+#include <dpsim-models/Solver/MNASwitchInterface.h>
+#include <dpsim-models/Solver/MNATearInterface.h>
+#include <dpsim-models/Solver/MNAVariableCompInterface.h>
+
+using namespace CPS;
+using namespace DPsim;
+
+DiakopticsPartitioner::DiakopticsPartitioner(Logger::Level logLevel) :
+	mSLog(Logger::get("DiakopticsPartitioner", logLevel)) { }
+
+Real DiakopticsPartitioner::Graph::totalWeight() const {
+	return std::accumulate(vertexWeights.begin(), vertexWeights.end(), 0.);
+}
+
+DiakopticsPartitioner::Graph DiakopticsPartitioner::buildGraph(std::vector<Real> vertexWeights, std::vector<Edge>& edges) {
+	Graph graph;
+	graph.vertexWeights = std::move(vertexWeights);
+	UInt size = graph.size();
+
+	std::vector<Edge> directed;
+	directed.reserve(2 * edges.size());
+	for (auto& edge : edges) {
+		if (edge.from == edge.to)
+			continue;
+		directed.push_back(edge);
+		directed.push_back({edge.to, edge.from, edge.weight});
+	}
+	std::sort(directed.begin(), directed.end(), [](const Edge& a, const Edge& b) {
+		return a.from < b.from || (a.from == b.from && a.to < b.to);
+	});
+
+	graph.offsets.assign(size + 1, 0);
+	UInt next = 0;
+	for (UInt vertex = 0; vertex < size; ++vertex) {
+		for (; next < directed.size() && directed[next].from == vertex; ++next) {
+			if (graph.neighbours.size() > graph.offsets[vertex] && graph.neighbours.back() == directed[next].to) {
+				graph.edgeWeights.back() += directed[next].weight;
+			} else {
+				graph.neighbours.push_back(directed[next].to);
+				graph.edgeWeights.push_back(directed[next].weight);
+			}
+		}
+		graph.offsets[vertex + 1] = static_cast<UInt>(graph.neighbours.size());
+	}
+
+	return graph;
+}
+
+DiakopticsPartitioner::Graph DiakopticsPartitioner::coarsen(const Graph& graph, Real maxVertexWeight, std::vector<UInt>& map) {
+	UInt size = graph.size();
+	const UInt unmatched = static_cast<UInt>(-1);
+	map.assign(size, unmatched);
+
+	// Visiting vertices with few neighbours first leaves fewer of them unmatched
+	std::vector<UInt> order(size);
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&graph](UInt a, UInt b) {
+		return graph.offsets[a+1] - graph.offsets[a] < graph.offsets[b+1] - graph.offsets[b];
+	});
+
+	std::vector<Real> coarseWeights;
+	for (UInt vertex : order) {
+		if (map[vertex] != unmatched)
+			continue;
+
+		UInt mate = unmatched;
+		for (UInt i = graph.offsets[vertex]; i < graph.offsets[vertex+1]; ++i) {
+			UInt other = graph.neighbours[i];
+			if (map[other] != unmatched
+				|| graph.vertexWeights[vertex] + graph.vertexWeights[other] > maxVertexWeight)
+				continue;
+			if (mate == unmatched || graph.edgeWeights[i] > graph.edgeWeights[mate]
+				|| (graph.edgeWeights[i] == graph.edgeWeights[mate]
+					&& graph.vertexWeights[other] < graph.vertexWeights[graph.neighbours[mate]]))
+				mate = i;
+		}
+
+		map[vertex] = static_cast<UInt>(coarseWeights.size());
+		coarseWeights.push_back(graph.vertexWeights[vertex]);
+		if (mate != unmatched) {
+			map[graph.neighbours[mate]] = map[vertex];
+			coarseWeights.back() += graph.vertexWeights[graph.neighbours[mate]];
+		}
+	}
+
+	std::vector<Edge> edges;
+	for (UInt vertex = 0; vertex < size; ++vertex) {
+		for (UInt i = graph.offsets[vertex]; i < graph.offsets[vertex+1]; ++i) {
+			if (vertex < graph.neighbours[i])
+				edges.push_back({map[vertex], map[graph.neighbours[i]], graph.edgeWeights[i]});
+		}
+	}
+	return buildGraph(std::move(coarseWeights), edges);
+}
+
+void DiakopticsPartitioner::bisect(const Graph& graph, const std::vector<UInt>& vertices,
+	UInt firstPart, UInt parts, const std::vector<Real>& targets, std::vector<UInt>& partition) {
+
+	if (parts <= 1 || vertices.size() <= 1) {
+		for (UInt vertex : vertices)
+			partition[vertex] = firstPart;
+		return;
+	}
+
+	UInt leftParts = parts / 2;
+	Real total = 0;
+	for (UInt vertex : vertices)
+		total += graph.vertexWeights[vertex];
+	Real leftTarget = std::accumulate(targets.begin() + firstPart, targets.begin() + firstPart + leftParts, 0.);
+	Real allTarget = std::accumulate(targets.begin() + firstPart, targets.begin() + firstPart + parts, 0.);
+	Real target = total * leftTarget / allTarget;
+
+	// 0: not in this set, 1: right side, 2: left side
+	std::vector<char> side(graph.size(), 0);
+	for (UInt vertex : vertices)
+		side[vertex] = 1;
+
+	// Grow the left side from a few start vertices and keep the smallest cut
+	std::vector<char> bestSide;
+	Real bestCut = 0;
+	UInt tries = std::min<UInt>(4, static_cast<UInt>(vertices.size()));
+	for (UInt attempt = 0; attempt < tries; ++attempt) {
+		std::vector<char> current = side;
+		// Reduction of the cut when moving a vertex to the left side
+		std::vector<Real> gain(graph.size(), 0);
+		for (UInt vertex : vertices) {
+			for (UInt i = graph.offsets[vertex]; i < graph.offsets[vertex+1]; ++i) {
+				if (side[graph.neighbours[i]] == 1)
+					gain[vertex] -= graph.edgeWeights[i];
+			}
+		}
+		std::priority_queue<std::pair<Real, UInt>> frontier;
+		Real weight = 0;
+		UInt nextSeed = attempt * static_cast<UInt>(vertices.size()) / tries;
+
+		while (weight < target) {
+			UInt vertex = 0;
+			Bool found = false;
+			while (!frontier.empty()) {
+				auto top = frontier.top();
+				frontier.pop();
+				if (current[top.second] == 1 && top.first == gain[top.second]) {
+					vertex = top.second;
+					found = true;
+					break;
+				}
+			}
+			// Disconnected remainder, continue from another vertex
+			for (UInt i = 0; !found && i < vertices.size(); ++i) {
+				UInt candidate = vertices[(nextSeed + i) % vertices.size()];
+				if (current[candidate] == 1) {
+					vertex = candidate;
+					found = true;
+				}
+			}
+			if (!found)
+				break;
+			// Stop if adding the vertex moves the split further away from the target
+			if (weight > 0 && weight + graph.vertexWeights[vertex] - target > target - weight)
+				break;
+
+			current[vertex] = 2;
+			weight += graph.vertexWeights[vertex];
+			for (UInt i = graph.offsets[vertex]; i < graph.offsets[vertex+1]; ++i) {
+				UInt other = graph.neighbours[i];
+				if (current[other] != 1)
+					continue;
+				gain[other] += 2 * graph.edgeWeights[i];
+				frontier.emplace(gain[other], other);
+			}
+		}
+
+		Real cut = 0;
+		for (UInt vertex : vertices) {
+			if (current[vertex] != 2)
+				continue;
+			for (UInt i = graph.offsets[vertex]; i < graph.offsets[vertex+1]; ++i) {
+				if (current[graph.neighbours[i]] == 1)
+					cut += graph.edgeWeights[i];
+			}
+		}
+		if (bestSide.empty() || cut < bestCut) {
+			bestSide = std::move(current);
+			bestCut = cut;
+		}
+	}
+
+	std::vector<UInt> left, right;
+	for (UInt vertex : vertices)
+		(bestSide[vertex] == 2 ? left : right).push_back(vertex);
+	bisect(graph, left, firstPart, leftParts, targets, partition);
+	bisect(graph, right, firstPart + leftParts, parts - leftParts, targets, partition);
+}
+
+void DiakopticsPartitioner::refine(const Graph& graph, const std::vector<Real>& maxPartWeights, std::vector<UInt>& partition) {
+	UInt parts = static_cast<UInt>(maxPartWeights.size());
+	std::vector<Real> partWeights(parts, 0);
+	for (UInt vertex = 0; vertex < graph.size(); ++vertex)
+		partWeights[partition[vertex]] += graph.vertexWeights[vertex];
+
+	std::vector<Real> connection(parts, 0);
+	std::vector<UInt> touched;
+	for (UInt pass = 0; pass < 8; ++pass) {
+		UInt moves = 0;
+		for (UInt vertex = 0; vertex < graph.size(); ++vertex) {
+			UInt from = partition[vertex];
+			Real weight = graph.vertexWeights[vertex];
+
+			touched.clear();
+			for (UInt i = graph.offsets[vertex]; i < graph.offsets[vertex+1]; ++i) {
+				UInt part = partition[graph.neighbours[i]];
+				if (connection[part] == 0)
+					touched.push_back(part);
+				connection[part] += graph.edgeWeights[i];
+			}
+
+			// Best neighbouring part that can take the vertex
+			UInt to = from;
+			Real bestGain = 0;
+			Bool overloaded = partWeights[from] > maxPartWeights[from];
+			for (UInt part : touched) {
+				if (part == from || partWeights[part] + weight > maxPartWeights[part])
+					continue;
+				// Loads are compared relative to the part's target
+				Real gain = connection[part] - connection[from];
+				Real load = (partWeights[part] + weight) / maxPartWeights[part];
+				Bool better = to == from ? (gain > 0 || overloaded
+						|| (gain == 0 && load < partWeights[from] / maxPartWeights[from]))
+					: (gain > bestGain || (gain == bestGain && partWeights[part] / maxPartWeights[part] < partWeights[to] / maxPartWeights[to]));
+				if (better) {
+					to = part;
+					bestGain = gain;
+				}
+			}
+			for (UInt part : touched)
+				connection[part] = 0;
+
+			// Never empty a part completely
+			if (to != from && partWeights[from] > weight) {
+				partition[vertex] = to;
+				partWeights[from] -= weight;
+				partWeights[to] += weight;
+				++moves;
+			}
+		}
+		if (moves == 0)
+			break;
+	}
+}
+
+std::vector<Real> DiakopticsPartitioner::subnetTargets(UInt parts, UInt threads) {
+	// Every subnet on its own thread, or subnets distributed round robin
+	// and each thread's share split evenly among its subnets
+	threads = std::max<UInt>(threads, 1);
+	if (parts <= threads)
+		return std::vector<Real>(parts, 1. / parts);
+
+	std::vector<Real> targets;
+	for (UInt thread = 0; thread < threads; ++thread) {
+		UInt threadParts = parts / threads + (thread < parts % threads ? 1 : 0);
+		for (UInt part = 0; part < threadParts; ++part)
+			targets.push_back(1. / (threads * threadParts));
+	}
+	return targets;
+}
+
+std::vector<UInt> DiakopticsPartitioner::partitionGraph(const Graph& graph, const std::vector<Real>& targets) {
+	UInt parts = static_cast<UInt>(targets.size());
+	Real total = graph.totalWeight();
+	std::vector<Real> maxPartWeights(parts);
+	for (UInt part = 0; part < parts; ++part)
+		maxPartWeights[part] = (1 + mWeights.imbalance) * total * targets[part];
+	Real maxVertexWeight = std::max(total / (4 * parts),
+		*std::max_element(graph.vertexWeights.begin(), graph.vertexWeights.end()));
+
+	// Coarsen until the graph is small compared to the number of parts
+	std::vector<Graph> levels { graph };
+	std::vector<std::vector<UInt>> maps;
+	UInt coarsestSize = std::max<UInt>(32, 8 * parts);
+	while (levels.back().size() > coarsestSize) {
+		std::vector<UInt> map;
+		Graph coarse = coarsen(levels.back(), maxVertexWeight, map);
+		if (coarse.size() > 0.95 * levels.back().size())
+			break;
+		levels.push_back(std::move(coarse));
+		maps.push_back(std::move(map));
+	}
+	mSLog->info("Coarsened {} vertices to {} in {} levels", graph.size(), levels.back().size(), maps.size());
+
+	std::vector<UInt> vertices(levels.back().size());
+	std::iota(vertices.begin(), vertices.end(), 0);
+	std::vector<UInt> partition(levels.back().size(), 0);
+	bisect(levels.back(), vertices, 0, parts, targets, partition);
+	refine(levels.back(), maxPartWeights, partition);
+
+	// Project back and refine on every level
+	for (Int level = static_cast<Int>(maps.size()) - 1; level >= 0; --level) {
+		std::vector<UInt> finer(levels[level].size());
+		for (UInt vertex = 0; vertex < finer.size(); ++vertex)
+			finer[vertex] = partition[maps[level][vertex]];
+		partition = std::move(finer);
+		refine(levels[level], maxPartWeights, partition);
+	}
+	return partition;
+}
+
+template <typename VarType>
+IdentifiedObject::List DiakopticsPartitioner::partition(SystemTopology& system, UInt subnets, UInt threads) {
+	UInt parts = subnets > 0 ? subnets : std::max<UInt>(threads, 1);
+
+	// Index the network nodes
+	std::unordered_map<typename SimNode<VarType>::Ptr, UInt> nodeIndices;
+	std::vector<typename SimNode<VarType>::Ptr> nodes;
+	auto nodeIndex = [&](typename SimNode<VarType>::Ptr node) {
+		auto it = nodeIndices.find(node);
+		if (it != nodeIndices.end())
+			return it->second;
+		UInt idx = static_cast<UInt>(nodes.size());
+		nodeIndices[node] = idx;
+		nodes.push_back(node);
+		return idx;
+	};
+	for (auto baseNode : system.mNodes) {
+		auto node = std::dynamic_pointer_cast<SimNode<VarType>>(baseNode);
+		if (node && !node->isGround())
+			nodeIndex(node);
+	}
+
+	// Contract the nodes connected by components that cannot be torn
+	std::vector<typename SimPowerComp<VarType>::Ptr> tearable;
+	std::vector<std::vector<UInt>> componentNodes;
+	std::vector<typename SimPowerComp<VarType>::Ptr> components;
+	for (auto comp : system.mComponents) {
+		auto pComp = std::dynamic_pointer_cast<SimPowerComp<VarType>>(comp);
+		if (!pComp)
+			continue;
+		std::vector<UInt> terminals;
+		for (UInt idx = 0; idx < pComp->terminalNumberConnected(); ++idx) {
+			if (!pComp->node(idx)->isGround())
+				terminals.push_back(nodeIndex(pComp->node(idx)));
+		}
+		components.push_back(pComp);
+		componentNodes.push_back(terminals);
+	}
+
+	std::vector<UInt> parent(nodes.size());
+	std::iota(parent.begin(), parent.end(), 0);
+	std::function<UInt(UInt)> find = [&](UInt idx) {
+		return parent[idx] == idx ? idx : (parent[idx] = find(parent[idx]));
+	};
+
+	std::vector<Bool> isTearable(components.size(), false);
+	for (UInt comp = 0; comp < components.size(); ++comp) {
+		auto& terminals = componentNodes[comp];
+		isTearable[comp] = std::dynamic_pointer_cast<MNATearInterface>(components[comp])
+			&& components[comp]->terminalNumber() == 2 && terminals.size() == 2
+			&& terminals[0] != terminals[1];
+		if (!isTearable[comp]) {
+			for (UInt idx = 1; idx < terminals.size(); ++idx)
+				parent[find(terminals[idx])] = find(terminals[0]);
+		}
+	}
+
+	std::vector<UInt> vertexOf(nodes.size());
+	std::unordered_map<UInt, UInt> vertexOfRoot;
+	for (UInt node = 0; node < nodes.size(); ++node) {
+		UInt root = find(node);
+		auto it = vertexOfRoot.find(root);
+		if (it == vertexOfRoot.end())
+			it = vertexOfRoot.emplace(root, static_cast<UInt>(vertexOfRoot.size())).first;
+		vertexOf[node] = it->second;
+	}
+
+	// Estimated cost of the matrix rows, non-zeros and nonlinear components
+	UInt rowsPerPhase = std::is_same<VarType, Complex>::value ? 2 : 1;
+	std::vector<Real> vertexWeights(vertexOfRoot.size(), 0);
+	for (UInt node = 0; node < nodes.size(); ++node) {
+		UInt phases = nodes[node]->phaseType() == PhaseType::ABC ? 3 : 1;
+		vertexWeights[vertexOf[node]] += mWeights.row * phases * rowsPerPhase;
+	}
+
+	std::vector<Edge> edges;
+	for (UInt comp = 0; comp < components.size(); ++comp) {
+		auto& terminals = componentNodes[comp];
+		if (terminals.empty())
+			continue;
+		auto pComp = components[comp];
+		UInt phases = nodes[terminals[0]]->phaseType() == PhaseType::ABC ? 3 : 1;
+		Real size = static_cast<Real>((terminals.size() + pComp->virtualNodesNumber()) * phases * rowsPerPhase);
+		Real cost = mWeights.nonZero * size * size + mWeights.row * pComp->virtualNodesNumber() * phases * rowsPerPhase;
+		if (std::dynamic_pointer_cast<MNASwitchInterface>(pComp) || std::dynamic_pointer_cast<MNAVariableCompInterface>(pComp))
+			cost += mWeights.nonlinear;
+		for (UInt node : terminals)
+			vertexWeights[vertexOf[node]] += cost / terminals.size();
+
+		if (isTearable[comp])
+			edges.push_back({vertexOf[terminals[0]], vertexOf[terminals[1]], 1.});
+	}
+
+	IdentifiedObject::List tearComponents;
+	if (vertexWeights.size() < 2 || parts < 2) {
+		mSLog->info("Nothing to partition");
+		return tearComponents;
+	}
+	parts = std::min<UInt>(parts, static_cast<UInt>(vertexWeights.size()));
+
+	Graph graph = buildGraph(vertexWeights, edges);
+	mSLog->info("Partitioning {} nodes contracted to {} vertices with {} tearable components into {} subnets",
+		nodes.size(), graph.size(), edges.size(), parts);
+	std::vector<UInt> partition = partitionGraph(graph, subnetTargets(parts, threads));
+
+	// Move the cut components to the tear components
+	std::unordered_set<IdentifiedObject::Ptr> torn;
+	for (UInt comp = 0; comp < components.size(); ++comp) {
+		if (!isTearable[comp])
+			continue;
+		auto& terminals = componentNodes[comp];
+		if (partition[vertexOf[terminals[0]]] != partition[vertexOf[terminals[1]]]) {
+			torn.insert(components[comp]);
+			tearComponents.push_back(components[comp]);
+		}
+	}
+	system.mComponents.erase(std::remove_if(system.mComponents.begin(), system.mComponents.end(),
+		[&torn](const IdentifiedObject::Ptr& comp) { return torn.count(comp) > 0; }), system.mComponents.end());
+	for (auto comp : tearComponents)
+		system.mTearComponents.push_back(comp);
+
+	// Report the balance, also for a distribution of the subnets to the threads
+	// by longest processing time, which matches the targets of subnetTargets
+	std::vector<Real> partWeights(parts, 0);
+	for (UInt vertex = 0; vertex < graph.size(); ++vertex)
+		partWeights[partition[vertex]] += graph.vertexWeights[vertex];
+	for (UInt part = 0; part < parts; ++part)
+		mSLog->info("Subnet {}: estimated cost {}", part, partWeights[part]);
+
+	std::vector<Real> sorted = partWeights;
+	std::sort(sorted.begin(), sorted.end(), std::greater<Real>());
+	std::vector<Real> threadWeights(std::max<UInt>(threads, 1), 0);
+	for (Real weight : sorted)
+		*std::min_element(threadWeights.begin(), threadWeights.end()) += weight;
+	mSLog->info("Torn {} components, estimated cost per step {} on {} threads, {} sequentially",
+		tearComponents.size(), *std::max_element(threadWeights.begin(), threadWeights.end()),
+		threadWeights.size(), graph.totalWeight());
+
+	return tearComponents;
+}
+
+template IdentifiedObject::List DiakopticsPartitioner::partition<Real>(SystemTopology& system, UInt subnets, UInt threads);
+template IdentifiedObject::List DiakopticsPartitioner::partition<Complex>(SystemTopology& system, UInt subnets, UInt threads);
@@ -8,11 +8,13 @@
 
 #include <dpsim/DiakopticsSolver.h>
 
+#include <algorithm>
 #include <iomanip>
 
 #include <dpsim-models/MathUtils.h>
 #include <dpsim-models/Solver/MNATearInterface.h>
 #include <dpsim/Definitions.h>
+#include <dpsim/InPlaceSolve.h>
 
 using namespace CPS;
 using namespace DPsim;
@@ -67,11 +69,20 @@ void DiakopticsSolver<VarType>::initSubnets(const std::vector<SystemTopology>& s
 		}
 
 		for (auto comp : subnets[i].mComponents) {
-			// TODO switches
 			auto mnaComp = std::dynamic_pointer_cast<CPS::MNAInterface>(comp);
 			if (mnaComp)
 				mSubnets[i].components.push_back(mnaComp);
 
+			// Switches and variable components change the subnet's block
+			auto swComp = std::dynamic_pointer_cast<CPS::MNASwitchInterface>(comp);
+			if (swComp)
+				mSubnets[i].switches.push_back(swComp);
+			auto varComp = std::dynamic_pointer_cast<CPS::MNAVariableCompInterface>(comp);
+			if (varComp)
+				mSubnets[i].variableComps.push_back(varComp);
+			if (mnaComp && (swComp || varComp))
+				mSubnets[i].variableComponents.push_back(mnaComp);
+
 			auto sigComp = std::dynamic_pointer_cast<CPS::SimSignalComp>(comp);
 			if (sigComp)
 				mSimSignalComps.push_back(sigComp);
@@ -207,8 +218,6 @@ void DiakopticsSolver<Complex>::setLogColumns() {
 template <typename VarType>
 void DiakopticsSolver<VarType>::createMatrices() {
 	UInt totalSize = mSubnets.back().sysOff + mSubnets.back().sysSize;
-	mSystemMatrix = Matrix::Zero(totalSize, totalSize);
-	mSystemInverse = Matrix::Zero(totalSize, totalSize);
 
 	mRightSideVector = Matrix::Zero(totalSize, 1);
 	mLeftSideVector = Matrix::Zero(totalSize, 1);
@@ -228,7 +237,7 @@ void DiakopticsSolver<VarType>::createMatrices() {
 
 template <>
 void DiakopticsSolver<Real>::createTearMatrices(UInt totalSize) {
-	mTearTopology = Matrix::Zero(totalSize, mTearComponents.size());
+	mTearTopology = SparseMatrix(totalSize, mTearComponents.size());
 	mTearImpedance = Matrix::Zero(mTearComponents.size(), mTearComponents.size());
 	mTearCurrents = Matrix::Zero(mTearComponents.size(), 1);
 	mTearVoltages = Matrix::Zero(mTearComponents.size(), 1);
@@ -236,7 +245,7 @@ void DiakopticsSolver<Real>::createTearMatrices(UInt totalSize) {
 
 template <>
 void DiakopticsSolver<Complex>::createTearMatrices(UInt totalSize) {
-	mTearTopology = Matrix::Zero(totalSize, 2*mTearComponents.size());
+	mTearTopology = SparseMatrix(totalSize, 2*mTearComponents.size());
 	mTearImpedance = Matrix::Zero(2*mTearComponents.size(), 2*mTearComponents.size());
 	mTearCurrents = Matrix::Zero(2*mTearComponents.size(), 1);
 	mTearVoltages = Matrix::Zero(2*mTearComponents.size(), 1);
@@ -268,33 +277,53 @@ void DiakopticsSolver<VarType>::initComponents() {
 template <typename VarType>
 void DiakopticsSolver<VarType>::initMatrices() {
 	for (auto& net : mSubnets) {
-		// We can't directly pass the block reference to mnaApplySystemMatrixStamp,
-		// because it expects a concrete Matrix. It can't be changed to accept some common
-		// base class like DenseBase because that would make it a template function (as
-		// Eigen uses CRTP for polymorphism), which is impossible for virtual functions.
-		Matrix partSys = Matrix::Zero(net.sysSize, net.sysSize);
-		for (auto comp : net.components) {
-			comp->mnaApplySystemMatrixStamp(partSys);
-		}
-		auto block = mSystemMatrix.block(net.sysOff, net.sysOff, net.sysSize, net.sysSize);
-		block = partSys;
-		mSLog->info("Block: \n{}", block);
-		net.luFactorization = Eigen::PartialPivLU<Matrix>(partSys);
-		mSLog->info("Factorization: \n{}", net.luFactorization.matrixLU());
+		// Every subnet is factorized separately, the block diagonal system
+		// matrix is never assembled.
+		createSubnetMatrix(net);
+		net.luFactorization = std::make_shared<LUFactorizedSparse>();
+		net.luFactorization->analyzePattern(net.systemMatrix);
+		net.luFactorization->factorize(net.systemMatrix);
+		if (net.luFactorization->info() != Eigen::Success)
+			throw SystemError("Factorization of subnet matrix failed");
+		mSLog->info("Block of size {} with {} non-zeros factorized, {} switches and {} variable components",
+			net.sysSize, net.systemMatrix.nonZeros(), net.switches.size(), net.variableComps.size());
 	}
-	mSLog->info("Complete system matrix: \n{}", mSystemMatrix);
 
 	// initialize tear topology matrix and impedance matrix of removed network
+	std::vector<Eigen::Triplet<Real>> topology;
 	for (UInt compIdx = 0; compIdx < mTearComponents.size(); ++compIdx) {
-		applyTearComponentStamp(compIdx);
+		applyTearComponentStamp(compIdx, topology);
 	}
-	mSLog->info("Topology matrix: \n{}", mTearTopology);
+	mTearTopology.setFromTriplets(topology.begin(), topology.end());
+	mTearTopology.makeCompressed();
+	mSLog->info("Topology matrix with {} tear columns", mTearTopology.cols());
 	mSLog->info("Removed impedance matrix: \n{}", mTearImpedance);
-	// TODO this can be sped up as well by using the block diagonal form of Yinv
+
 	for (auto& net : mSubnets) {
-		mSystemInverse.block(net.sysOff, net.sysOff, net.sysSize, net.sysSize) = net.luFactorization.inverse();
+		// Only the tear columns incident to a subnet contribute to its impedance
+		SparseMatrix netTopology = mTearTopology.middleRows(net.sysOff, net.sysSize);
+		std::vector<Eigen::Triplet<Real>> entries;
+		std::vector<Int> localColumn(netTopology.cols(), -1);
+		for (Eigen::Index row = 0; row < netTopology.outerSize(); ++row) {
+			for (SparseMatrix::InnerIterator it(netTopology, row); it; ++it) {
+				if (localColumn[it.col()] < 0) {
+					localColumn[it.col()] = static_cast<Int>(net.tearColumns.size());
+					net.tearColumns.push_back(static_cast<UInt>(it.col()));
+				}
+				entries.emplace_back(static_cast<Int>(row), localColumn[it.col()], it.value());
+			}
+		}
+		net.tearTopology = CPS::SparseMatrix(net.sysSize, net.tearColumns.size());
+		net.tearTopology.setFromTriplets(entries.begin(), entries.end());
+		net.tearImpedance = Matrix::Zero(net.tearColumns.size(), net.tearColumns.size());
+		net.nextTearImpedance = Matrix::Zero(net.tearColumns.size(), net.tearColumns.size());
+		net.tearRightSide = Matrix(net.tearTopology);
+		net.tearSolution = Matrix::Zero(net.sysSize, net.tearColumns.size());
+		net.tearSolveWork = Matrix::Zero(net.sysSize, net.tearColumns.size());
+		computeSubnetTearImpedance(net);
 	}
-	mTotalTearImpedance = Eigen::PartialPivLU<Matrix>(mTearImpedance + mTearTopology.transpose() * mSystemInverse * mTearTopology);
+	mTotalTearImpedanceMatrix = mTearImpedance;
+	factorizeTearImpedance();
 	mSLog->info("Total removed impedance matrix LU decomposition: \n{}", mTotalTearImpedance.matrixLU());
 
 	// Compute subnet right side (source) vectors for debugging
@@ -308,27 +337,162 @@ void DiakopticsSolver<VarType>::initMatrices() {
 	}
 }
 
+template <typename VarType>
+void DiakopticsSolver<VarType>::createSubnetMatrix(Subnet& net) {
+	// Components stamp into a sparse matrix of the subnet size
+	SparseMatrix base(net.sysSize, net.sysSize);
+	for (auto comp : net.components) {
+		if (std::find(net.variableComponents.begin(), net.variableComponents.end(), comp) == net.variableComponents.end())
+			comp->mnaApplySystemMatrixStamp(base);
+	}
+	base.makeCompressed();
+
+	net.stampMatrix = base;
+	for (auto comp : net.variableComponents)
+		comp->mnaApplySystemMatrixStamp(net.stampMatrix);
+	net.stampMatrix.makeCompressed();
+
+	// The constant pattern is a subset of the complete one, so coeffRef
+	// only looks up existing slots here
+	net.baseValues.assign(net.stampMatrix.nonZeros(), 0);
+	const Real* values = net.stampMatrix.valuePtr();
+	for (Int row = 0; row < base.outerSize(); ++row) {
+		for (SparseMatrix::InnerIterator it(base, row); it; ++it)
+			net.baseValues[&net.stampMatrix.coeffRef(it.row(), it.col()) - values] = it.value();
+	}
+
+	// The storage order is converted once, refactorizations only move the values
+	net.systemMatrix = net.stampMatrix;
+	net.systemMatrixIndex.assign(net.stampMatrix.nonZeros(), 0);
+	for (Int col = 0; col < net.systemMatrix.outerSize(); ++col) {
+		for (CPS::SparseMatrix::InnerIterator it(net.systemMatrix, col); it; ++it)
+			net.systemMatrixIndex[&net.stampMatrix.coeffRef(it.row(), it.col()) - values] =
+				static_cast<UInt>(&it.valueRef() - net.systemMatrix.valuePtr());
+	}
+
+	net.switchStatus.resize(net.switches.size());
+	for (UInt sw = 0; sw < net.switches.size(); ++sw)
+		net.switchStatus[sw] = net.switches[sw]->mnaIsClosed();
+}
+
+template <typename VarType>
+Bool DiakopticsSolver<VarType>::hasSubnetChanged(Subnet& net) {
+	Bool changed = false;
+	for (UInt sw = 0; sw < net.switches.size(); ++sw) {
+		Bool closed = net.switches[sw]->mnaIsClosed();
+		changed = changed || closed != net.switchStatus[sw];
+		net.switchStatus[sw] = closed;
+	}
+	// Every component is asked as the check may update its internal state
+	for (auto comp : net.variableComps) {
+		if (comp->hasParameterChanged())
+			changed = true;
+	}
+	return changed;
+}
+
+template <typename VarType>
+void DiakopticsSolver<VarType>::updateSubnetMatrix(Subnet& net) {
+	std::copy(net.baseValues.begin(), net.baseValues.end(), net.stampMatrix.valuePtr());
+	for (auto comp : net.variableComponents)
+		comp->mnaApplySystemMatrixStamp(net.stampMatrix);
+
+	// Stamps outside the initial pattern leave the matrix uncompressed
+	if (!net.stampMatrix.isCompressed()) {
+		mSLog->warn("Subnet matrix stamp outside of initial sparsity pattern");
+		createSubnetMatrix(net);
+		net.luFactorization->analyzePattern(net.systemMatrix);
+	} else {
+		const Real* values = net.stampMatrix.valuePtr();
+		Real* systemValues = net.systemMatrix.valuePtr();
+		for (UInt i = 0; i < net.systemMatrixIndex.size(); ++i)
+			systemValues[net.systemMatrixIndex[i]] = values[i];
+	}
+	net.luFactorization->factorize(net.systemMatrix);
+	if (net.luFactorization->info() != Eigen::Success)
+		throw SystemError("Refactorization of subnet matrix failed");
+	computeSubnetTearImpedance(net);
+}
+
+template <typename VarType>
+void DiakopticsSolver<VarType>::computeSubnetTearImpedance(Subnet& net) {
+	if (net.tearColumns.empty())
+		return;
+
+	// Y^-1 * C from sparse solves against the incident tear columns only
+	solveInPlace(*net.luFactorization, net.tearRightSide, net.tearSolution, net.tearSolveWork);
+
+	// C^T * Y^-1 * C, each tear column only has the entries of its component's nodes
+	for (Int i = 0; i < net.tearTopology.outerSize(); ++i) {
+		for (UInt j = 0; j < net.tearColumns.size(); ++j) {
+			Real sum = 0;
+			for (CPS::SparseMatrix::InnerIterator it(net.tearTopology, i); it; ++it)
+				sum += it.value() * net.tearSolution(it.row(), j);
+			net.nextTearImpedance(i, j) = sum;
+		}
+	}
+	net.changed = true;
+}
+
+template <typename VarType>
+void DiakopticsSolver<VarType>::factorizeTearImpedance() {
+	// As the system matrix is block diagonal, C^T * Y^-1 * C is the sum of
+	// the contributions of all subnets, so only those of changed subnets
+	// are exchanged. The subnet tasks run in parallel and share tear columns,
+	// that is why this is done here and not after each refactorization.
+	for (auto& net : mSubnets) {
+		if (!net.changed)
+			continue;
+		for (UInt i = 0; i < net.tearColumns.size(); ++i) {
+			for (UInt j = 0; j < net.tearColumns.size(); ++j)
+				mTotalTearImpedanceMatrix(net.tearColumns[i], net.tearColumns[j])
+					+= net.nextTearImpedance(i, j) - net.tearImpedance(i, j);
+		}
+		net.tearImpedance.swap(net.nextTearImpedance);
+		net.changed = false;
+		++mTearImpedanceUpdates;
+	}
+	if (mTearImpedanceUpdates >= mTearImpedanceResumInterval)
+		sumTearImpedance();
+	mTotalTearImpedance.compute(mTotalTearImpedanceMatrix);
+}
+
+template <typename VarType>
+void DiakopticsSolver<VarType>::sumTearImpedance() {
+	mTotalTearImpedanceMatrix = mTearImpedance;
+	for (auto& net : mSubnets) {
+		for (UInt i = 0; i < net.tearColumns.size(); ++i) {
+			for (UInt j = 0; j < net.tearColumns.size(); ++j)
+				mTotalTearImpedanceMatrix(net.tearColumns[i], net.tearColumns[j]) += net.tearImpedance(i, j);
+		}
+	}
+	mTearImpedanceUpdates = 0;
+}
+
 template <>
-void DiakopticsSolver<Real>::applyTearComponentStamp(UInt compIdx) {
+void DiakopticsSolver<Real>::applyTearComponentStamp(UInt compIdx, std::vector<Eigen::Triplet<Real>>& topology) {
 	auto comp = mTearComponents[compIdx];
-	mTearTopology(mNodeSubnetMap[comp->node(0)]->sysOff + comp->node(0)->matrixNodeIndex(), compIdx) = 1;
-	mTearTopology(mNodeSubnetMap[comp->node(1)]->sysOff + comp->node(1)->matrixNodeIndex(), compIdx) = -1;
+	Int col = static_cast<Int>(compIdx);
+	topology.emplace_back(mNodeSubnetMap[comp->node(0)]->sysOff + comp->node(0)->matrixNodeIndex(), col, 1);
+	topology.emplace_back(mNodeSubnetMap[comp->node(1)]->sysOff + comp->node(1)->matrixNodeIndex(), col, -1);
 
 	auto tearComp = std::dynamic_pointer_cast<MNATearInterface>(comp);
 	tearComp->mnaTearApplyMatrixStamp(mTearImpedance);
 }
 
 template <>
-void DiakopticsSolver<Complex>::applyTearComponentStamp(UInt compIdx) {
+void DiakopticsSolver<Complex>::applyTearComponentStamp(UInt compIdx, std::vector<Eigen::Triplet<Real>>& topology) {
 	auto comp = mTearComponents[compIdx];
 
 	auto net1 = mNodeSubnetMap[comp->node(0)];
 	auto net2 = mNodeSubnetMap[comp->node(1)];
+	Int colRe = static_cast<Int>(compIdx);
+	Int colIm = static_cast<Int>(mTearComponents.size() + compIdx);
 
-	mTearTopology(net1->sysOff + comp->node(0)->matrixNodeIndex(), compIdx) = 1;
-	mTearTopology(net1->sysOff + net1->mCmplOff + comp->node(0)->matrixNodeIndex(), mTearComponents.size() + compIdx) = 1;
-	mTearTopology(net2->sysOff + comp->node(1)->matrixNodeIndex(), compIdx) = -1;
-	mTearTopology(net2->sysOff + net2->mCmplOff + comp->node(1)->matrixNodeIndex(), mTearComponents.size() + compIdx) = -1;
+	topology.emplace_back(net1->sysOff + comp->node(0)->matrixNodeIndex(), colRe, 1);
+	topology.emplace_back(net1->sysOff + net1->mCmplOff + comp->node(0)->matrixNodeIndex(), colIm, 1);
+	topology.emplace_back(net2->sysOff + comp->node(1)->matrixNodeIndex(), colRe, -1);
+	topology.emplace_back(net2->sysOff + net2->mCmplOff + comp->node(1)->matrixNodeIndex(), colIm, -1);
 
 	auto tearComp = std::dynamic_pointer_cast<MNATearInterface>(comp);
 	tearComp->mnaTearApplyMatrixStamp(mTearImpedance);
@@ -367,6 +531,10 @@ Task::List DiakopticsSolver<VarType>::getTasks() {
 
 template <typename VarType>
 void DiakopticsSolver<VarType>::SubnetSolveTask::execute(Real time, Int timeStepCount) {
+	// Only subnets with changed switches or components are refactorized
+	if (DiakopticsSolver<VarType>::hasSubnetChanged(mSubnet))
+		mSolver.updateSubnetMatrix(mSubnet);
+
 	auto rBlock = mSolver.mRightSideVector.block(mSubnet.sysOff, 0, mSubnet.sysSize, 1);
 	rBlock.setZero();
 
@@ -375,11 +543,18 @@ void DiakopticsSolver<VarType>::SubnetSolveTask::execute(Real time, Int timeStep
 
 	auto lBlock = (**mSolver.mOrigLeftSideVector).block(mSubnet.sysOff, 0, mSubnet.sysSize, 1);
 	// Solve Y' * v' = I
-	lBlock = mSubnet.luFactorization.solve(rBlock);
+	lBlock = mSubnet.luFactorization->solve(rBlock);
 }
 
 template <typename VarType>
 void DiakopticsSolver<VarType>::PreSolveTask::execute(Real time, Int timeStepCount) {
+	for (auto& net : mSolver.mSubnets) {
+		if (net.changed) {
+			mSolver.factorizeTearImpedance();
+			break;
+		}
+	}
+
 	mSolver.mTearVoltages.setZero();
 	for (auto comp : mSolver.mTearComponents) {
 		auto tComp = std::dynamic_pointer_cast<MNATearInterface>(comp);
@@ -400,7 +575,7 @@ void DiakopticsSolver<VarType>::SolveTask::execute(Real time, Int timeStepCount)
 	auto rBlock = (**mSolver.mMappedTearCurrents).block(mSubnet.sysOff, 0, mSubnet.sysSize, 1);
 	// Solve Y' * x = C * i
 	// v = v' + x
-	lBlock += mSubnet.luFactorization.solve(rBlock);
+	lBlock += mSubnet.luFactorization->solve(rBlock);
 	**mSubnet.leftVector = lBlock;
 }
 
@@ -1,5 +1,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
+#include <algorithm>
+
 #include <dpsim/Interface.h>
 #include <dpsim/InterfaceWorker.h>
 
@@ -15,7 +17,23 @@ namespace DPsim {
             mInterfaceReaderThread = std::thread(Interface::ReaderThread(mQueueInterfaceToDpsim, mInterfaceWorker, mOpened));
         }
         if (!mExportAttrsDpsim.empty()) {
-            mInterfaceWriterThread = std::thread(Interface::WriterThread(mQueueDpsimToInterface, mInterfaceWorker));
+            createExportSlots();
+            mInterfaceWriterThread = std::thread(Interface::WriterThread(mQueueDpsimToInterface, mInterfaceWorker, mFreeExportSlots));
+        }
+    }
+
+    void Interface::createExportSlots() {
+        mExportSlots.clear();
+        mFreeExportSlots.clear();
+        mExportSlots.reserve(mExportAttrsDpsim.size() * mNumExportSlots);
+
+        for (UInt i = 0; i < mExportAttrsDpsim.size(); i++) {
+            auto freeSlots = std::make_shared<FreeSlotQueue>(mNumExportSlots);
+            for (UInt slot = 0; slot < mNumExportSlots; slot++) {
+                freeSlots->enqueue(static_cast<UInt>(mExportSlots.size()));
+                mExportSlots.push_back(std::get<0>(mExportAttrsDpsim[i])->cloneValueOntoNewAttribute());
+            }
+            mFreeExportSlots.push_back(freeSlots);
         }
     }
 
@@ -77,6 +95,13 @@ namespace DPsim {
         mExportAttrsDpsim.emplace_back(attr, 0);
     }
 
+    void Interface::pinThreads(Int cpu) {
+        for (auto thread : { &mInterfaceReaderThread, &mInterfaceWriterThread }) {
+            if (thread->joinable() && !Scheduler::pinThread(*thread, cpu))
+                mLog->warn("Failed to pin interface thread to CPU {}", cpu);
+        }
+    }
+
     void Interface::setLogger(CPS::Logger::Log log) {
         mLog = log;
         if (mInterfaceWorker != nullptr)
@@ -137,11 +162,24 @@ namespace DPsim {
 
     void Interface::pushDpsimAttrsToQueue() {
         for (UInt i = 0; i < mExportAttrsDpsim.size(); i++) {
+            auto& attr = std::get<0>(mExportAttrsDpsim[i]);
+
+            //Copy the value into a free preallocated slot. Only if the worker still holds all slots of this attribute, a new value is allocated
+            UInt slot = NO_EXPORT_SLOT;
+            CPS::AttributeBase::Ptr value;
+            if (i < mFreeExportSlots.size() && mFreeExportSlots[i]->try_dequeue(slot) && mExportSlots[slot]->copyValue(attr)) {
+                value = mExportSlots[slot];
+            } else {
+                slot = NO_EXPORT_SLOT;
+                value = attr->cloneValueOntoNewAttribute();
+            }
+
             mQueueDpsimToInterface->emplace(AttributePacket {
-                std::get<0>(mExportAttrsDpsim[i])->cloneValueOntoNewAttribute(),
+                value,
                 i,
                 std::get<1>(mExportAttrsDpsim[i]),
-                AttributePacketFlags::PACKET_NO_FLAGS
+                AttributePacketFlags::PACKET_NO_FLAGS,
+                slot
             });
             std::get<1>(mExportAttrsDpsim[i]) = mCurrentSequenceDpsimToInterface;
             mCurrentSequenceDpsimToInterface++;
@@ -151,6 +189,7 @@ namespace DPsim {
     void Interface::WriterThread::operator() () const {
         bool interfaceClosed = false;
         std::vector<Interface::AttributePacket> attrsToWrite;
+        std::vector<Interface::AttributePacket> attrsOffered;
         while (!interfaceClosed) {
             AttributePacket nextPacket = {
                 nullptr,
@@ -175,7 +214,23 @@ namespace DPsim {
                     attrsToWrite.push_back(nextPacket);
                 }
             }
+            attrsOffered.assign(attrsToWrite.begin(), attrsToWrite.end());
             mInterfaceWorker->writeValuesToEnv(attrsToWrite);
+            releaseSlots(attrsOffered, attrsToWrite);
+        }
+    }
+
+    void Interface::WriterThread::releaseSlots(const std::vector<AttributePacket>& offered, const std::vector<AttributePacket>& kept) const {
+        for (const auto& packet : offered) {
+            if (packet.slotId == NO_EXPORT_SLOT)
+                continue;
+
+            //Packets left in the list are still owned by the worker and are released in a later call
+            bool isKept = std::any_of(kept.cbegin(), kept.cend(), [&packet](const auto& keptPacket) {
+                return keptPacket.slotId == packet.slotId;
+            });
+            if (!isKept)
+                mFreeExportSlots[packet.attributeId]->try_enqueue(packet.slotId);
         }
     }
 
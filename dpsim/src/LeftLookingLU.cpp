@@ -0,0 +1,461 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/LeftLookingLU.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace DPsim;
+using namespace CPS;
+
+namespace {
+	/// Pivots of a refactorization below this fraction of their column are rejected
+	const Real refactorTolerance = 1e-10;
+}
+
+void LeftLookingLU::analyzePattern(const CPS::SparseMatrix& mat) {
+	if (mat.rows() != mat.cols() || !mat.isCompressed())
+		throw SystemError("Left-looking LU requires a square compressed matrix");
+
+	Int n = static_cast<Int>(mat.rows());
+	const Int* Ap = mat.outerIndexPtr();
+	const Int* Ai = mat.innerIndexPtr();
+	mSize = static_cast<UInt>(n);
+	mFactorized = false;
+	mPatternOuter.assign(Ap, Ap + n + 1);
+	mPatternInner.assign(Ai, Ai + Ap[n]);
+
+	// Maximum transversal, cheap assignment preferring diagonal entries
+	std::vector<Int> colMatch(n, -1), rowMatch(n, -1);
+	for (Int col = 0; col < n; ++col) {
+		for (Int p = Ap[col]; p < Ap[col + 1]; ++p) {
+			if (Ai[p] == col) {
+				colMatch[col] = col;
+				rowMatch[col] = col;
+			}
+		}
+	}
+	for (Int col = 0; col < n; ++col) {
+		for (Int p = Ap[col]; p < Ap[col + 1] && colMatch[col] < 0; ++p) {
+			if (rowMatch[Ai[p]] < 0) {
+				colMatch[col] = Ai[p];
+				rowMatch[Ai[p]] = col;
+			}
+		}
+	}
+
+	// Augmenting paths by depth-first search for the remaining columns
+	std::vector<Int> visited(n, -1), stackCols(n), stackRows(n), next(n);
+	for (Int start = 0; start < n; ++start) {
+		if (colMatch[start] >= 0)
+			continue;
+
+		Int head = 0;
+		Int freeRow = -1;
+		stackCols[0] = start;
+		next[start] = Ap[start];
+		while (head >= 0 && freeRow < 0) {
+			Int col = stackCols[head];
+			Bool descended = false;
+			for (Int p = next[col]; p < Ap[col + 1]; ++p) {
+				Int row = Ai[p];
+				if (visited[row] == start)
+					continue;
+				visited[row] = start;
+				next[col] = p + 1;
+				if (rowMatch[row] < 0) {
+					freeRow = row;
+				} else {
+					++head;
+					stackCols[head] = rowMatch[row];
+					stackRows[head] = row;
+					next[rowMatch[row]] = Ap[rowMatch[row]];
+					descended = true;
+				}
+				break;
+			}
+			if (!descended && freeRow < 0)
+				--head;
+		}
+		if (freeRow < 0)
+			throw SystemError("System matrix is structurally singular");
+
+		// Every column on the path takes the row leading to the next one
+		for (Int row = freeRow; head >= 0; --head) {
+			Int col = stackCols[head];
+			rowMatch[row] = col;
+			colMatch[col] = row;
+			row = stackRows[head];
+		}
+	}
+
+	// Strongly connected components of the column graph with the matched rows
+	// on the diagonal. Tarjan's algorithm emits a component after all components
+	// it depends on, which is an upper block triangular order.
+	std::vector<Int> index(n, -1), low(n), callStack, componentStack;
+	std::vector<Bool> onStack(n, false);
+	std::vector<Int> order;
+	order.reserve(n);
+	mBlockStart.clear();
+	Int counter = 0;
+	for (Int root = 0; root < n; ++root) {
+		if (index[root] >= 0)
+			continue;
+
+		auto visit = [&](Int node) {
+			index[node] = low[node] = counter++;
+			next[node] = Ap[node];
+			callStack.push_back(node);
+			componentStack.push_back(node);
+			onStack[node] = true;
+		};
+		visit(root);
+		while (!callStack.empty()) {
+			Int node = callStack.back();
+			if (next[node] < Ap[node + 1]) {
+				Int succ = rowMatch[Ai[next[node]++]];
+				if (index[succ] < 0)
+					visit(succ);
+				else if (onStack[succ])
+					low[node] = std::min(low[node], index[succ]);
+				continue;
+			}
+
+			callStack.pop_back();
+			if (!callStack.empty())
+				low[callStack.back()] = std::min(low[callStack.back()], low[node]);
+			if (low[node] == index[node]) {
+				mBlockStart.push_back(static_cast<Int>(order.size()));
+				Int member;
+				do {
+					member = componentStack.back();
+					componentStack.pop_back();
+					onStack[member] = false;
+					order.push_back(member);
+				} while (member != node);
+			}
+		}
+	}
+	mBlockStart.push_back(n);
+
+	// Approximate minimum degree ordering within each block
+	std::vector<Int> nodeBlock(n), localPos(n);
+	mBlockOf.resize(n);
+	for (UInt block = 0; block < numBlocks(); ++block) {
+		for (Int k = mBlockStart[block]; k < mBlockStart[block + 1]; ++k) {
+			mBlockOf[k] = block;
+			nodeBlock[order[k]] = block;
+			localPos[order[k]] = k - mBlockStart[block];
+		}
+	}
+	for (UInt block = 0; block < numBlocks(); ++block) {
+		Int k1 = mBlockStart[block], k2 = mBlockStart[block + 1];
+		if (k2 - k1 <= 2)
+			continue;
+
+		std::vector<Eigen::Triplet<Real>> entries;
+		for (Int k = k1; k < k2; ++k) {
+			for (Int p = Ap[order[k]]; p < Ap[order[k] + 1]; ++p) {
+				Int node = rowMatch[Ai[p]];
+				if (nodeBlock[node] == static_cast<Int>(block))
+					entries.emplace_back(localPos[node], k - k1, 1);
+			}
+		}
+		CPS::SparseMatrix blockPattern(k2 - k1, k2 - k1);
+		blockPattern.setFromTriplets(entries.begin(), entries.end());
+
+		// The ordering lists the block column for each new position
+		Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic, Int> perm;
+		Eigen::AMDOrdering<Int> amd;
+		amd(blockPattern, perm);
+		std::vector<Int> blockOrder(order.begin() + k1, order.begin() + k2);
+		for (Int k = k1; k < k2; ++k)
+			order[k] = blockOrder[perm.indices()[k - k1]];
+	}
+
+	mColOrder = order;
+	mColPos.resize(n);
+	mRowAnalysisPos.resize(n);
+	mMatchedRow.resize(n);
+	for (Int k = 0; k < n; ++k) {
+		mColPos[mColOrder[k]] = k;
+		mMatchedRow[k] = colMatch[mColOrder[k]];
+		mRowAnalysisPos[mMatchedRow[k]] = k;
+	}
+
+	mPinv.assign(n, -1);
+	mPivotRow.assign(n, -1);
+	mX.assign(n, 0);
+	mMark.assign(n, -1);
+	mReach.resize(n);
+	mStack.resize(n);
+	mStackPos.resize(n);
+	mBlockFrom.resize(numBlocks());
+	mWork = Matrix::Zero(n, 1);
+}
+
+Bool LeftLookingLU::hasPattern(const CPS::SparseMatrix& mat) const {
+	if (static_cast<UInt>(mat.rows()) != mSize || mat.cols() != mat.rows() || !mat.isCompressed()
+		|| static_cast<std::size_t>(mat.nonZeros()) != mPatternInner.size())
+		return false;
+	return std::equal(mPatternOuter.begin(), mPatternOuter.end(), mat.outerIndexPtr())
+		&& std::equal(mPatternInner.begin(), mPatternInner.end(), mat.innerIndexPtr());
+}
+
+void LeftLookingLU::factorize(const CPS::SparseMatrix& mat) {
+	if (!hasPattern(mat))
+		analyzePattern(mat);
+
+	mFactorized = false;
+	mLp.assign(1, 0);
+	mLi.clear();
+	mLx.clear();
+	mUp.assign(1, 0);
+	mUi.clear();
+	mUx.clear();
+	mFp.assign(1, 0);
+	mFi.clear();
+	mFx.clear();
+	std::fill(mPinv.begin(), mPinv.end(), -1);
+	std::fill(mMark.begin(), mMark.end(), -1);
+
+	for (UInt block = 0; block < numBlocks(); ++block)
+		factorizeBlock(block, mat);
+
+	mFactorized = true;
+	mLastRefactorizedColumns = mSize;
+}
+
+void LeftLookingLU::reach(Int start, Int mark, Int& top) {
+	Int head = 0;
+	mStack[0] = start;
+	while (head >= 0) {
+		Int pos = mStack[head];
+		Int piv = mPinv[pos];
+		if (mMark[pos] != mark) {
+			mMark[pos] = mark;
+			mStackPos[head] = piv < 0 ? 0 : mLp[piv];
+		}
+
+		// Rows that are already pivotal continue through their column of L
+		Bool done = true;
+		Int end = piv < 0 ? 0 : mLp[piv + 1];
+		for (Int q = mStackPos[head]; q < end; ++q) {
+			if (mMark[mLi[q]] == mark)
+				continue;
+			mStackPos[head] = q + 1;
+			mStack[++head] = mLi[q];
+			done = false;
+			break;
+		}
+		if (done) {
+			--head;
+			mReach[--top] = pos;
+		}
+	}
+}
+
+void LeftLookingLU::factorizeBlock(UInt block, const CPS::SparseMatrix& mat) {
+	const Int* Ap = mat.outerIndexPtr();
+	const Int* Ai = mat.innerIndexPtr();
+	const Real* Ax = mat.valuePtr();
+	Int k1 = mBlockStart[block], k2 = mBlockStart[block + 1];
+
+	// mX and the rows of L of this block are indexed by the positions of
+	// analyzePattern until the block is finished
+	for (Int k = k1; k < k2; ++k) {
+		Int col = mColOrder[k];
+		Int top = static_cast<Int>(mSize);
+		for (Int p = Ap[col]; p < Ap[col + 1]; ++p) {
+			Int pos = mRowAnalysisPos[Ai[p]];
+			if (pos < k1) {
+				mFi.push_back(mPinv[pos]);
+				mFx.push_back(Ax[p]);
+			} else if (mMark[pos] != k) {
+				reach(pos, k, top);
+			}
+		}
+		mFp.push_back(static_cast<Int>(mFi.size()));
+
+		// Sparse triangular solve with the columns of L reached from the matrix column
+		for (Int t = top; t < static_cast<Int>(mSize); ++t)
+			mX[mReach[t]] = 0;
+		for (Int p = Ap[col]; p < Ap[col + 1]; ++p) {
+			Int pos = mRowAnalysisPos[Ai[p]];
+			if (pos >= k1)
+				mX[pos] = Ax[p];
+		}
+		for (Int t = top; t < static_cast<Int>(mSize); ++t) {
+			Int piv = mPinv[mReach[t]];
+			if (piv < 0)
+				continue;
+			Real xj = mX[mReach[t]];
+			for (Int q = mLp[piv]; q < mLp[piv + 1]; ++q)
+				mX[mLi[q]] -= mLx[q] * xj;
+		}
+
+		// Partial pivoting, keeping the matched row if it is large enough
+		Int pivot = -1;
+		Real maxAbs = 0;
+		for (Int t = top; t < static_cast<Int>(mSize); ++t) {
+			Int pos = mReach[t];
+			if (mPinv[pos] >= 0) {
+				mUi.push_back(mPinv[pos]);
+				mUx.push_back(mX[pos]);
+			} else if (std::abs(mX[pos]) > maxAbs) {
+				maxAbs = std::abs(mX[pos]);
+				pivot = pos;
+			}
+		}
+		if (pivot < 0 || !(maxAbs > 0) || !std::isfinite(maxAbs))
+			throw SystemError("System matrix is numerically singular");
+		if (mPinv[k] < 0 && mMark[k] == k && std::abs(mX[k]) >= mPivotTolerance * maxAbs)
+			pivot = k;
+
+		Real diag = mX[pivot];
+		mUi.push_back(k);
+		mUx.push_back(diag);
+		mUp.push_back(static_cast<Int>(mUi.size()));
+		mPinv[pivot] = k;
+		mPivotRow[k] = mMatchedRow[pivot];
+
+		for (Int t = top; t < static_cast<Int>(mSize); ++t) {
+			Int pos = mReach[t];
+			if (mPinv[pos] < 0) {
+				mLi.push_back(pos);
+				mLx.push_back(mX[pos] / diag);
+			}
+		}
+		mLp.push_back(static_cast<Int>(mLi.size()));
+	}
+
+	// All rows of the block are pivotal now
+	for (Int q = mLp[k1]; q < mLp[k2]; ++q)
+		mLi[q] = mPinv[mLi[q]];
+}
+
+Bool LeftLookingLU::refactorize(const CPS::SparseMatrix& mat) {
+	if (!mFactorized)
+		return false;
+
+	for (UInt block = 0; block < numBlocks(); ++block) {
+		if (!refactorizeBlock(block, mBlockStart[block], mat)) {
+			mFactorized = false;
+			return false;
+		}
+	}
+	mLastRefactorizedColumns = mSize;
+	return true;
+}
+
+Bool LeftLookingLU::refactorize(const CPS::SparseMatrix& mat, const std::vector<UInt>& columns) {
+	if (!mFactorized)
+		return false;
+
+	Int none = std::numeric_limits<Int>::max();
+	std::fill(mBlockFrom.begin(), mBlockFrom.end(), none);
+	for (UInt col : columns) {
+		Int pos = mColPos[col];
+		mBlockFrom[mBlockOf[pos]] = std::min(mBlockFrom[mBlockOf[pos]], pos);
+	}
+
+	mLastRefactorizedColumns = 0;
+	for (UInt block = 0; block < numBlocks(); ++block) {
+		if (mBlockFrom[block] == none)
+			continue;
+		if (!refactorizeBlock(block, mBlockFrom[block], mat)) {
+			mFactorized = false;
+			return false;
+		}
+		mLastRefactorizedColumns += mBlockStart[block + 1] - mBlockFrom[block];
+	}
+	return true;
+}
+
+Bool LeftLookingLU::refactorizeBlock(UInt block, Int from, const CPS::SparseMatrix& mat) {
+	const Int* Ap = mat.outerIndexPtr();
+	const Int* Ai = mat.innerIndexPtr();
+	const Real* Ax = mat.valuePtr();
+	Int k1 = mBlockStart[block], k2 = mBlockStart[block + 1];
+
+	// The pivot order and the patterns of L and U are kept, mX is indexed by
+	// pivot positions
+	for (Int k = from; k < k2; ++k) {
+		Int col = mColOrder[k];
+		Int diagIdx = mUp[k + 1] - 1;
+		for (Int q = mUp[k]; q <= diagIdx; ++q)
+			mX[mUi[q]] = 0;
+		for (Int q = mLp[k]; q < mLp[k + 1]; ++q)
+			mX[mLi[q]] = 0;
+
+		Int f = mFp[k];
+		for (Int p = Ap[col]; p < Ap[col + 1]; ++p) {
+			Int pos = mRowAnalysisPos[Ai[p]];
+			if (pos < k1)
+				mFx[f++] = Ax[p];
+			else
+				mX[mPinv[pos]] = Ax[p];
+		}
+
+		// U is stored in the topological order of the updates
+		for (Int q = mUp[k]; q < diagIdx; ++q) {
+			Int j = mUi[q];
+			Real xj = mX[j];
+			mUx[q] = xj;
+			for (Int r = mLp[j]; r < mLp[j + 1]; ++r)
+				mX[mLi[r]] -= mLx[r] * xj;
+		}
+
+		Real diag = mX[k];
+		Real maxAbs = std::abs(diag);
+		for (Int q = mLp[k]; q < mLp[k + 1]; ++q)
+			maxAbs = std::max(maxAbs, std::abs(mX[mLi[q]]));
+		if (!(std::abs(diag) > refactorTolerance * maxAbs) || !std::isfinite(maxAbs))
+			return false;
+
+		mUx[diagIdx] = diag;
+		for (Int q = mLp[k]; q < mLp[k + 1]; ++q)
+			mLx[q] = mX[mLi[q]] / diag;
+	}
+	return true;
+}
+
+void LeftLookingLU::solveInPlace(const Matrix& rhs, Matrix& lhs) {
+	Real* y = mWork.data();
+	Int n = static_cast<Int>(mSize);
+	for (Int k = 0; k < n; ++k)
+		y[k] = rhs(mPivotRow[k], 0);
+
+	// Block back substitution, each block is solved with its factors and
+	// then removed from the right side of the preceding blocks
+	for (Int block = static_cast<Int>(numBlocks()) - 1; block >= 0; --block) {
+		Int k1 = mBlockStart[block], k2 = mBlockStart[block + 1];
+		for (Int k = k1; k < k2; ++k) {
+			Real yk = y[k];
+			for (Int q = mLp[k]; q < mLp[k + 1]; ++q)
+				y[mLi[q]] -= mLx[q] * yk;
+		}
+		for (Int k = k2 - 1; k >= k1; --k) {
+			Int diagIdx = mUp[k + 1] - 1;
+			y[k] /= mUx[diagIdx];
+			Real yk = y[k];
+			for (Int q = mUp[k]; q < diagIdx; ++q)
+				y[mUi[q]] -= mUx[q] * yk;
+		}
+		for (Int k = k1; k < k2; ++k) {
+			Real yk = y[k];
+			for (Int q = mFp[k]; q < mFp[k + 1]; ++q)
+				y[mFi[q]] -= mFx[q] * yk;
+		}
+	}
+
+	for (Int k = 0; k < n; ++k)
+		lhs(mColOrder[k], 0) = y[k];
+}
@@ -10,6 +10,7 @@
 #include <dpsim/MNASolver.h>
 #include <dpsim/SequentialScheduler.h>
 #include <memory>
+#include <functional>
 
 using namespace DPsim;
 using namespace CPS;
@@ -122,14 +123,17 @@ void MnaSolver<Real>::initializeComponents() {
 	// Initialize MNA specific parts of components.
 	for (auto comp : allMNAComps) {
 		comp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, attributeTyped<Matrix>("left_vector"));
-		const Matrix& stamp = comp->template attributeTyped<Matrix>("right_vector")->get();
-		if (stamp.size() != 0) {
-			mRightVectorStamps.push_back(&stamp);
-		}
+		addRightVectorStamp(comp);
 	}
 
 	for (auto comp : mMNAIntfSwitches)
 		comp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, attributeTyped<Matrix>("left_vector"));
+
+	// The voltage updates only depend on the solution, so they can run in parallel
+	if (mNodeVoltageTasks) {
+		for (UInt nodeIdx = 0; nodeIdx < mNumNetNodes; ++nodeIdx)
+			mNodes[nodeIdx]->mnaInitialize(attributeTyped<Matrix>("left_vector"));
+	}
 }
 
 template <>
@@ -159,8 +163,7 @@ void MnaSolver<Complex>::initializeComponents() {
 		for (auto comp : mMNAComponents) {
 			// Initialize MNA specific parts of components.
 			comp->mnaInitializeHarm(mSystem.mSystemOmega, mTimeStep, mLeftSideVectorHarm);
-			const Matrix& stamp = comp->template attributeTyped<Matrix>("right_vector")->get();
-			if (stamp.size() != 0) mRightVectorStamps.push_back(&stamp);
+			addRightVectorStamp(comp);
 		}
 		// Initialize nodes
 		for (UInt nodeIdx = 0; nodeIdx < mNodes.size(); ++nodeIdx) {
@@ -171,14 +174,17 @@ void MnaSolver<Complex>::initializeComponents() {
 		// Initialize MNA specific parts of components.
 		for (auto comp : allMNAComps) {
 			comp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, attributeTyped<Matrix>("left_vector"));
-			const Matrix& stamp = comp->template attributeTyped<Matrix>("right_vector")->get();
-			if (stamp.size() != 0) {
-				mRightVectorStamps.push_back(&stamp);
-			}
+			addRightVectorStamp(comp);
 		}
 
 		for (auto comp : mMNAIntfSwitches)
 			comp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, attributeTyped<Matrix>("left_vector"));
+
+		// The voltage updates only depend on the solution, so they can run in parallel
+		if (mNodeVoltageTasks) {
+			for (UInt nodeIdx = 0; nodeIdx < mNumNetNodes; ++nodeIdx)
+				mNodes[nodeIdx]->mnaInitialize(attributeTyped<Matrix>("left_vector"));
+		}
 	}
 }
 
@@ -300,6 +306,85 @@ void MnaSolver<VarType>::updateSwitchStatus() {
 	}
 }
 
+template <typename VarType>
+void MnaSolver<VarType>::addRightVectorStamp(CPS::MNAInterface::Ptr comp) {
+	const Matrix& stamp = comp->template attributeTyped<Matrix>("right_vector")->get();
+	if (stamp.size() == 0)
+		return;
+
+	// A component can only inject into the nodes it is connected to and into
+	// its own virtual nodes, including the ones of its subcomponents.
+	std::vector<UInt> nodeIndices;
+	std::function<void(typename SimPowerComp<VarType>::Ptr)> collectIndices =
+		[&](typename SimPowerComp<VarType>::Ptr pComp) {
+			for (auto terminal : pComp->terminals()) {
+				auto node = terminal->node();
+				if (node && !node->isGround())
+					for (auto idx : node->matrixNodeIndices())
+						nodeIndices.push_back(idx);
+			}
+			for (auto node : pComp->virtualNodes())
+				for (auto idx : node->matrixNodeIndices())
+					nodeIndices.push_back(idx);
+			for (auto subComp : pComp->subComponents())
+				collectIndices(subComp);
+			if (auto mnaComp = std::dynamic_pointer_cast<MNAInterface>(pComp))
+				mnaComp->mnaAddRightVectorNodeIndices(nodeIndices);
+		};
+
+	std::vector<Bool> rowUsed(stamp.rows(), false);
+	auto pComp = std::dynamic_pointer_cast<SimPowerComp<VarType>>(comp);
+	if (pComp && mNumMatrixNodeIndices > 0) {
+		collectIndices(pComp);
+		// Real and imaginary parts as well as additional frequencies are stored
+		// in consecutive blocks with the size of the number of matrix nodes
+		for (Matrix::Index block = 0; block < stamp.rows() / mNumMatrixNodeIndices; ++block)
+			for (auto idx : nodeIndices)
+				rowUsed[idx + block * mNumMatrixNodeIndices] = true;
+	}
+
+	// Fall back to adding the complete vector if the stamp already
+	// contains values outside of the expected rows
+	Bool fullStamp = !pComp;
+	for (Matrix::Index row = 0; row < stamp.rows() && !fullStamp; ++row) {
+		if (!rowUsed[row] && stamp.row(row).any())
+			fullStamp = true;
+	}
+	if (fullStamp) {
+		auto idObj = std::dynamic_pointer_cast<IdentifiedObject>(comp);
+		mSLog->info("Right vector of {:s} is added as a dense stamp", idObj ? idObj->name() : "component");
+	}
+
+	std::vector<UInt> rows;
+	for (Matrix::Index row = 0; row < stamp.rows(); ++row)
+		if (fullStamp || rowUsed[row])
+			rows.push_back(static_cast<UInt>(row));
+
+	// Stamps of parallel frequencies have a column per frequency and are added completely
+	comp->mnaSetRightVectorRows(fullStamp || stamp.cols() > 1 ? std::vector<UInt>() : rows);
+	mRightVectorStamps.push_back(&stamp);
+	mRightVectorStampRows.push_back(rows);
+	auto idObj = std::dynamic_pointer_cast<IdentifiedObject>(comp);
+	mRightVectorStampNames.push_back(idObj ? idObj->name() : "component");
+	mRightVectorStampChecked.push_back(fullStamp);
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::sumRightVectorStamps() {
+	for (std::size_t i = 0; i < mRightVectorStamps.size(); ++i) {
+		const Matrix& stamp = *mRightVectorStamps[i];
+		for (auto row : mRightVectorStampRows[i])
+			mRightSideVector(row, 0) += stamp(row, 0);
+		// Values written to rows the component did not declare would be lost,
+		// so every stamp is checked until it has values, in debug builds in
+		// every step
+#ifdef NDEBUG
+		if (!mRightVectorStampChecked[i])
+#endif
+			mRightVectorStampChecked[i] = MNAInterface::checkRightVectorRows(stamp, mRightVectorStampRows[i], mRightVectorStampNames[i]);
+	}
+}
+
 template <typename VarType>
 void MnaSolver<VarType>::identifyTopologyObjects() {
 	for (auto baseNode : mSystem.mNodes) {
@@ -576,6 +661,14 @@ Task::List MnaSolver<VarType>::getTasks() {
 }
 
 
+template <typename VarType>
+void MnaSolver<VarType>::warmUp() {
+	// The sum keeps the reads from being optimized away
+	volatile Real sum = mRightSideVector.sum() + (**mLeftSideVector).sum();
+	for (auto stamp : mRightVectorStamps)
+		sum = sum + stamp->sum();
+}
+
 template <typename VarType>
 void MnaSolver<VarType>::log(Real time, Int timeStepCount) {
 	if (mLogLevel == Logger::Level::off)
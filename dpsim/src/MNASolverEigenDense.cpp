@@ -17,6 +17,7 @@ namespace DPsim {
 
 template <typename VarType>
 MnaSolverEigenDense<VarType>::MnaSolverEigenDense(String name, CPS::Domain domain, CPS::Logger::Level logLevel) : MnaSolver<VarType>(name, domain, logLevel) {
+	this->mNodeVoltageTasks = true;
 }
 
 template <typename VarType>
@@ -35,11 +36,15 @@ void MnaSolverEigenDense<VarType>::switchedMatrixStamp(std::size_t index, MNAInt
 	auto bit = std::bitset<SWITCH_NUM>(index);
 	auto& sys = mSwitchedMatrices[bit][0];
 
+	// Components stamp into a sparse matrix, which is densified once
+	SparseMatrix sparseSys(sys.rows(), sys.cols());
 	for (auto comp : components)
-		comp->mnaApplySystemMatrixStamp(sys);
+		comp->mnaApplySystemMatrixStamp(sparseSys);
 
 	for (UInt i = 0; i < mSwitches.size(); ++i)
-		mSwitches[i]->mnaApplySwitchSystemMatrixStamp(bit[i], sys, 0);
+		mSwitches[i]->mnaApplySwitchSystemMatrixStamp(bit[i], sparseSys, 0);
+
+	sys += Matrix(sparseSys);
 
 	// Compute LU-factorization for system matrix
 	mLuFactorizations[bit][0].compute(sys);
@@ -52,11 +57,14 @@ void MnaSolverEigenDense<VarType>::switchedMatrixStamp(std::size_t swIdx, Int fr
 	auto bit = std::bitset<SWITCH_NUM>(swIdx);
 	auto& sys = mSwitchedMatrices[bit][freqIdx];
 
+	SparseMatrix sparseSys(sys.rows(), sys.cols());
 	for (auto comp : components)
-		comp->mnaApplySystemMatrixStampHarm(sys, freqIdx);
+		comp->mnaApplySystemMatrixStampHarm(sparseSys, freqIdx);
 
 	for (UInt i = 0; i < switches.size(); ++i)
-		switches[i]->mnaApplySwitchSystemMatrixStamp(bit[i], sys, freqIdx);
+		switches[i]->mnaApplySwitchSystemMatrixStamp(bit[i], sparseSys, freqIdx);
+
+	sys += Matrix(sparseSys);
 
 	mLuFactorizations[bit][freqIdx].compute(sys);
 }
@@ -65,6 +73,7 @@ template <>
 void MnaSolverEigenDense<Real>::createEmptySystemMatrix() {
 	if (mSwitches.size() > SWITCH_NUM)
 		throw SystemError("Too many Switches.");
+	mActiveLu = nullptr;
 
 	for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++) {
 		auto bit = std::bitset<SWITCH_NUM>(i);
@@ -77,6 +86,7 @@ template <>
 void MnaSolverEigenDense<Complex>::createEmptySystemMatrix() {
 	if (mSwitches.size() > SWITCH_NUM)
 		throw SystemError("Too many Switches.");
+	mActiveLu = nullptr;
 
 	if (mFrequencyParallel) {
 		for (UInt i = 0; i < std::pow(2,mSwitches.size()); ++i) {
@@ -121,20 +131,22 @@ void MnaSolverEigenDense<VarType>::solve(Real time, Int timeStepCount) {
 
 	// Add together the right side vector (computed by the components'
 	// pre-step tasks)
-	for (auto stamp : mRightVectorStamps)
-		mRightSideVector += *stamp;
+	MnaSolver<VarType>::sumRightVectorStamps();
 
 	if (!mIsInInitialization)
 		MnaSolver<VarType>::updateSwitchStatus();
 
-	if (mSwitchedMatrices.size() > 0)
-		**mLeftSideVector = mLuFactorizations[mCurrentSwitchStatus][0].solve(mRightSideVector);
+	// The factorization is only looked up when the switch state changed
+	if (!mActiveLu || mCurrentSwitchStatus != mActiveSwitchStatus) {
+		mActiveSwitchStatus = mCurrentSwitchStatus;
+		auto lu = mLuFactorizations.find(mCurrentSwitchStatus);
+		mActiveLu = lu != mLuFactorizations.end() ? &lu->second[0] : nullptr;
+	}
 
-	// TODO split into separate task? (dependent on x, updating all v attributes)
-	for (UInt nodeIdx = 0; nodeIdx < mNumNetNodes; ++nodeIdx)
-		mNodes[nodeIdx]->mnaUpdateVoltage(**mLeftSideVector);
+	if (mActiveLu)
+		solveInPlace(*mActiveLu, mRightSideVector, **mLeftSideVector);
 
-	// Components' states will be updated by the post-step tasks
+	// Node voltages and components' states will be updated by the post-step tasks
 }
 
 template <typename VarType>
@@ -9,6 +9,8 @@
 #include <dpsim/MNASolverEigenSparse.h>
 #include <dpsim/SequentialScheduler.h>
 
+#include <algorithm>
+
 using namespace DPsim;
 using namespace CPS;
 
@@ -16,7 +18,10 @@ namespace DPsim {
 
 
 template <typename VarType>
-MnaSolverEigenSparse<VarType>::MnaSolverEigenSparse(String name, CPS::Domain domain, CPS::Logger::Level logLevel) :	MnaSolver<VarType>(name, domain, logLevel) {
+MnaSolverEigenSparse<VarType>::MnaSolverEigenSparse(String name, CPS::Domain domain, CPS::Logger::Level logLevel) :	MnaSolver<VarType>(name, domain, logLevel),
+	mSwitchCacheHits(CPS::Attribute<Int>::create("switch_cache_hits", this->mAttributes, 0)),
+	mSwitchCacheMisses(CPS::Attribute<Int>::create("switch_cache_misses", this->mAttributes, 0)) {
+	this->mNodeVoltageTasks = true;
 }
 
 
@@ -36,16 +41,138 @@ void MnaSolverEigenSparse<VarType>::switchedMatrixStamp(std::size_t index, std::
 	auto bit = std::bitset<SWITCH_NUM>(index);
 	auto& sys = mSwitchedMatrices[bit][0];
 	for (auto comp : comp) {
-		comp->mnaApplySparseSystemMatrixStamp(sys);
+		comp->mnaApplySystemMatrixStamp(sys);
 	}
 	for (UInt i = 0; i < mSwitches.size(); ++i)
-		mSwitches[i]->mnaApplySwitchSparseSystemMatrixStamp(bit[i], sys, 0);
+		mSwitches[i]->mnaApplySwitchSystemMatrixStamp(bit[i], sys, 0);
+
+	// Ensemble members are solved with the factorizations of the leader
+	if (mEnsembleLeader) {
+		// Compare the dimensions first, isApprox requires equal sizes
+		if (mSwitches.size() != mEnsembleLeader->mSwitches.size())
+			throw SystemError("Scenario " + this->mName + " has a different system matrix than the ensemble");
+		auto& leaderSys = mEnsembleLeader->mSwitchedMatrices[bit][0];
+		if (sys.rows() != leaderSys.rows() || sys.cols() != leaderSys.cols() || !sys.isApprox(leaderSys))
+			throw SystemError("Scenario " + this->mName + " has a different system matrix than the ensemble");
+		return;
+	}
 
 	// Compute LU-factorization for system matrix
 	mLuFactorizations[bit][0]->analyzePattern(sys);
 	mLuFactorizations[bit][0]->factorize(sys);
 }
 
+template <typename VarType>
+void MnaSolverEigenSparse<VarType>::initializeSystemWithPrecomputedMatrices() {
+	mActiveLu = nullptr;
+	mSolveWork = Matrix::Zero((**mLeftSideVector).rows(), 1);
+	mWarmUpVector = Matrix::Zero((**mLeftSideVector).rows(), 1);
+	if (!mEnsembleMembers.empty()) {
+		mEnsembleRightSide = Matrix::Zero((**mLeftSideVector).rows(), mEnsembleMembers.size() + 1);
+		mEnsembleLeftSide = Matrix::Zero((**mLeftSideVector).rows(), mEnsembleMembers.size() + 1);
+		mEnsembleWork = Matrix::Zero((**mLeftSideVector).rows(), mEnsembleMembers.size() + 1);
+		for (auto member : mEnsembleMembers) {
+			member->mActiveLu = nullptr;
+			member->mSolveWork = Matrix::Zero((**mLeftSideVector).rows(), 1);
+		}
+		mSLog->info("Solving {} scenarios in lockstep", mEnsembleMembers.size() + 1);
+	}
+
+	if (!isLazySwitchFactorization()) {
+		MnaSolver<VarType>::initializeSystemWithPrecomputedMatrices();
+		return;
+	}
+
+	mSLog->info("Factorizing switch states on demand (cache limit: {} bytes)",
+		mSwitchFactorizationCacheLimit);
+
+	// Drop matrices of a previous initialization, components may have changed
+	mSwitchedMatrices.clear();
+	mLuFactorizations.clear();
+	mSwitchCacheOrder.clear();
+	mSwitchCachePositions.clear();
+	mSwitchCacheEntryBytes.clear();
+	mSwitchCacheBytes = 0;
+
+	if (mSwitches.size() > 0)
+		MnaSolver<VarType>::updateSwitchStatus();
+	activateSwitchStatus(mCurrentSwitchStatus);
+
+	// Initialize source vector for debugging
+	for (auto comp : mMNAComponents)
+		comp->mnaApplyRightSideVectorStamp(mRightSideVector);
+}
+
+template <typename VarType>
+void MnaSolverEigenSparse<VarType>::activateSwitchStatus(const std::bitset<SWITCH_NUM>& status) {
+	mActiveSwitchStatus = status;
+
+	auto pos = mSwitchCachePositions.find(status);
+	if (pos != mSwitchCachePositions.end()) {
+		mSwitchCacheOrder.splice(mSwitchCacheOrder.begin(), mSwitchCacheOrder, pos->second);
+		mActiveLu = mLuFactorizations[status][0].get();
+		++(**mSwitchCacheHits);
+		return;
+	}
+
+	// The left side vector has the dimension of the system matrix
+	auto size = (**mLeftSideVector).rows();
+	mSwitchedMatrices[status].push_back(SparseMatrix(size, size));
+	mLuFactorizations[status].push_back(std::make_shared<LUFactorizedSparse>());
+	switchedMatrixStamp(status.to_ullong(), mMNAComponents);
+
+	mSwitchCacheOrder.push_front(status);
+	mSwitchCachePositions[status] = mSwitchCacheOrder.begin();
+	// The estimate depends on the factorization in use, so the same value
+	// has to be subtracted on eviction
+	std::size_t bytes = switchMatrixBytes(status);
+	mSwitchCacheEntryBytes[status] = bytes;
+	mSwitchCacheBytes += bytes;
+	mActiveLu = mLuFactorizations[status][0].get();
+	++(**mSwitchCacheMisses);
+
+	evictSwitchMatrices();
+}
+
+template <typename VarType>
+void MnaSolverEigenSparse<VarType>::updateActiveFactorization() {
+	if (isLazySwitchFactorization()) {
+		activateSwitchStatus(mCurrentSwitchStatus);
+		return;
+	}
+
+	mActiveSwitchStatus = mCurrentSwitchStatus;
+	auto& luFactorizations = mEnsembleLeader ? mEnsembleLeader->mLuFactorizations : mLuFactorizations;
+	auto lu = luFactorizations.find(mCurrentSwitchStatus);
+	mActiveLu = lu != luFactorizations.end() ? lu->second[0].get() : nullptr;
+}
+
+template <typename VarType>
+void MnaSolverEigenSparse<VarType>::evictSwitchMatrices() {
+	if (mSwitchFactorizationCacheLimit == 0)
+		return;
+
+	// The most recently used state is always kept
+	while (mSwitchCacheBytes > mSwitchFactorizationCacheLimit && mSwitchCacheOrder.size() > 1) {
+		auto status = mSwitchCacheOrder.back();
+		auto bytes = mSwitchCacheEntryBytes.find(status);
+		mSwitchCacheBytes -= bytes->second;
+		mSwitchCacheEntryBytes.erase(bytes);
+		mSwitchCacheOrder.pop_back();
+		mSwitchCachePositions.erase(status);
+		mSwitchedMatrices.erase(status);
+		mLuFactorizations.erase(status);
+		mSLog->debug("Evicted factorization of switch state {:s}", status.to_string());
+	}
+}
+
+template <typename VarType>
+std::size_t MnaSolverEigenSparse<VarType>::switchMatrixBytes(const std::bitset<SWITCH_NUM>& status) {
+	auto& lu = mLuFactorizations[status][0];
+	std::size_t nonZeros = mSwitchedMatrices[status][0].nonZeros() + lu->nnzL() + lu->nnzU();
+	return nonZeros * (sizeof(Real) + sizeof(SparseMatrix::StorageIndex));
+}
+
 template <typename VarType>
 void MnaSolverEigenSparse<VarType>::stampVariableSystemMatrix() {
 
@@ -57,7 +184,7 @@ void MnaSolverEigenSparse<VarType>::stampVariableSystemMatrix() {
 	// Build base matrix with only static elements
 	mBaseSystemMatrix.setZero();
 	for (auto statElem : mMNAComponents)
-		statElem->mnaApplySparseSystemMatrixStamp(mBaseSystemMatrix);
+		statElem->mnaApplySystemMatrixStamp(mBaseSystemMatrix);
 	mSLog->info("Base matrix with only static elements: {}", Logger::matrixToString(mBaseSystemMatrix));
 	mSLog->flush();
 
@@ -67,19 +194,30 @@ void MnaSolverEigenSparse<VarType>::stampVariableSystemMatrix() {
 	// Now stamp switches into matrix
 	mSLog->info("Stamping switches");
 	for (auto sw : mMNAIntfSwitches)
-		sw->mnaApplySparseSystemMatrixStamp(mVariableSystemMatrix);
+		sw->mnaApplySystemMatrixStamp(mVariableSystemMatrix);
 
 	// Now stamp initial state of variable elements into matrix
 	mSLog->info("Stamping variable elements");
 	for (auto varElem : mMNAIntfVariableComps)
-		varElem->mnaApplySparseSystemMatrixStamp(mVariableSystemMatrix);
+		varElem->mnaApplySystemMatrixStamp(mVariableSystemMatrix);
 
 	mSLog->info("Initial system matrix with variable elements {}", Logger::matrixToString(mVariableSystemMatrix));
 	mSLog->flush();
 
+	createVariableSystemPattern();
+
 	// Calculate factorization of current matrix
 	mLuFactorizationVariableSystemMatrix.analyzePattern(mVariableSystemMatrix);
 	mLuFactorizationVariableSystemMatrix.factorize(mVariableSystemMatrix);
+	mFactorizedSystemMatrix = mVariableSystemMatrix;
+	mUpdateColumns.clear();
+	mSolveWork = Matrix::Zero(mVariableSystemMatrix.rows(), 1);
+	mWarmUpVector = Matrix::Zero(mVariableSystemMatrix.rows(), 1);
+	if (mLowRankUpdates)
+		allocateLowRankUpdates();
+
+	if (mSchurComplementUpdates)
+		initializeSchurComplement();
 }
 
 template <typename VarType>
@@ -89,42 +227,303 @@ void MnaSolverEigenSparse<VarType>::solveWithSystemMatrixRecomputation(Real time
 
 	// Add together the right side vector (computed by the components'
 	// pre-step tasks)
-	for (auto stamp : mRightVectorStamps)
-		mRightSideVector += *stamp;
+	MnaSolver<VarType>::sumRightVectorStamps();
 
 	// Get switch and variable comp status and update system matrix and lu factorization accordingly
 	if (hasVariableComponentChanged())
 		recomputeSystemMatrix(time);
 
 	// Calculate new solution vector
-	**mLeftSideVector = mLuFactorizationVariableSystemMatrix.solve(mRightSideVector);
+	if (mSchurActive) {
+		solveSchurComplement();
+	} else {
+		solveInPlace(mLuFactorizationVariableSystemMatrix, mRightSideVector, **mLeftSideVector, mSolveWork);
+		if (!mUpdateColumns.empty())
+			applyLowRankCorrection();
+	}
 
-	// TODO split into separate task? (dependent on x, updating all v attributes)
-	for (UInt nodeIdx = 0; nodeIdx < mNumNetNodes; ++nodeIdx)
-		mNodes[nodeIdx]->mnaUpdateVoltage(**mLeftSideVector);
+	// Node voltages and components' states will be updated by the post-step tasks
+}
 
-	// Components' states will be updated by the post-step tasks
+template <typename VarType>
+void MnaSolverEigenSparse<VarType>::createVariableSystemPattern() {
+	mVariableSystemMatrix.makeCompressed();
+
+	// The base pattern is a subset of the variable pattern, so coeffRef
+	// only looks up existing slots here
+	mBaseSystemValues.assign(mVariableSystemMatrix.nonZeros(), 0);
+	const Real* values = mVariableSystemMatrix.valuePtr();
+	for (Int row = 0; row < mBaseSystemMatrix.outerSize(); ++row) {
+		for (SparseMatrix::InnerIterator it(mBaseSystemMatrix, row); it; ++it)
+			mBaseSystemValues[&mVariableSystemMatrix.coeffRef(it.row(), it.col()) - values] = it.value();
+	}
 }
 
 template <typename VarType>
-void MnaSolverEigenSparse<VarType>::recomputeSystemMatrix(Real time) {
-	// Start from base matrix
-	mVariableSystemMatrix = mBaseSystemMatrix;
+Bool MnaSolverEigenSparse<VarType>::restampVariableSystemMatrix() {
+	// Start from base matrix values
+	std::copy(mBaseSystemValues.begin(), mBaseSystemValues.end(), mVariableSystemMatrix.valuePtr());
 
 	// Now stamp switches into matrix
 	for (auto sw : mMNAIntfSwitches)
-		sw->mnaApplySparseSystemMatrixStamp(mVariableSystemMatrix);
+		sw->mnaApplySystemMatrixStamp(mVariableSystemMatrix);
 
 	// Now stamp variable elements into matrix
 	for (auto comp : mMNAIntfVariableComps)
-		comp->mnaApplySparseSystemMatrixStamp(mVariableSystemMatrix);
+		comp->mnaApplySystemMatrixStamp(mVariableSystemMatrix);
 
-	// Refactorization of matrix assuming that structure remained
-	// constant by omitting analyzePattern
+	// Stamps outside the initial pattern leave the matrix uncompressed
+	if (mVariableSystemMatrix.isCompressed())
+		return false;
+
+	mSLog->warn("Variable system matrix stamp outside of initial sparsity pattern");
+	createVariableSystemPattern();
+	return true;
+}
+
+template <typename VarType>
+void MnaSolverEigenSparse<VarType>::recomputeSystemMatrix(Real time) {
+	Bool patternChanged = restampVariableSystemMatrix();
+
+	// Only the interface block changes, so only the Schur complement is refactorized
+	if (mSchurActive) {
+		if (patternChanged)
+			initializeSchurComplement();
+		else
+			updateSchurComplement();
+		if (mSchurActive) {
+			++mNumSchurUpdates;
+			return;
+		}
+		// Otherwise the pattern changed and the whole matrix is factorized below
+	}
+
+	// Keep the factorization if the change is of low rank
+	if (!patternChanged && mLowRankUpdates && updateLowRankCorrection()) {
+		++mNumLowRankUpdates;
+		return;
+	}
+
+	// Refactorization of matrix reusing the symbolic analysis
+	// as long as the structure remained constant
+	if (patternChanged)
+		mLuFactorizationVariableSystemMatrix.analyzePattern(mVariableSystemMatrix);
 	mLuFactorizationVariableSystemMatrix.factorize(mVariableSystemMatrix);
+	// The pattern only grows when stamps leave it, so a matrix with the same
+	// number of non-zeros has the same pattern and only the values are copied
+	if (mFactorizedSystemMatrix.nonZeros() != mVariableSystemMatrix.nonZeros())
+		mFactorizedSystemMatrix = mVariableSystemMatrix;
+	else
+		std::copy(mVariableSystemMatrix.valuePtr(), mVariableSystemMatrix.valuePtr() + mVariableSystemMatrix.nonZeros(),
+			mFactorizedSystemMatrix.valuePtr());
+	mUpdateColumns.clear();
 	++mNumRecomputations;
 }
 
+template <typename VarType>
+void MnaSolverEigenSparse<VarType>::allocateLowRankUpdates() {
+	UInt size = mVariableSystemMatrix.rows();
+	UInt maxRank = mLowRankUpdateMaxRank;
+
+	mUpdateColumns.reserve(maxRank + 1);
+	mUpdateEntries.reserve(mVariableSystemMatrix.nonZeros());
+	mUpdateSolutions = Matrix::Zero(size, maxRank);
+	mUpdateColumn = Matrix::Zero(size, 1);
+	mUpdateColumnSolution = Matrix::Zero(size, 1);
+	mUpdateCapacitanceMatrix = Matrix::Identity(maxRank, maxRank);
+	mUpdateCapacitance = Eigen::PartialPivLU<Matrix>(maxRank);
+	mUpdateSelection = Matrix::Zero(maxRank, 1);
+	mUpdateWeights = Matrix::Zero(maxRank, 1);
+}
+
+template <typename VarType>
+Bool MnaSolverEigenSparse<VarType>::updateLowRankCorrection() {
+	// The difference is written as D = C * E^T, where C holds the changed
+	// columns of D and E the corresponding unit vectors. Both matrices share
+	// the pattern, so the changed entries are found in the value arrays.
+	if (mFactorizedSystemMatrix.nonZeros() != mVariableSystemMatrix.nonZeros())
+		return false;
+
+	const Int* outer = mVariableSystemMatrix.outerIndexPtr();
+	const Int* inner = mVariableSystemMatrix.innerIndexPtr();
+	const Real* values = mVariableSystemMatrix.valuePtr();
+	const Real* factorizedValues = mFactorizedSystemMatrix.valuePtr();
+
+	mUpdateColumns.clear();
+	mUpdateEntries.clear();
+	for (Int row = 0; row < mVariableSystemMatrix.outerSize(); ++row) {
+		for (Int p = outer[row]; p < outer[row + 1]; ++p) {
+			if (values[p] == factorizedValues[p])
+				continue;
+			mUpdateEntries.emplace_back(p, row);
+			UInt col = inner[p];
+			if (std::find(mUpdateColumns.begin(), mUpdateColumns.end(), col) == mUpdateColumns.end()) {
+				if (mUpdateColumns.size() == mLowRankUpdateMaxRank)
+					return false;
+				mUpdateColumns.push_back(col);
+			}
+		}
+	}
+	if (mUpdateColumns.empty())
+		return true;
+
+	// Woodbury identity: (A + C E^T)^-1 = A^-1 - A^-1 C (I + E^T A^-1 C)^-1 E^T A^-1
+	// The capacitance matrix keeps the size of the maximum rank, unused
+	// columns of the solutions are zero and the rows of the identity
+	UInt rank = mUpdateColumns.size();
+	for (UInt i = 0; i < rank; ++i) {
+		mUpdateColumn.setZero();
+		for (auto& entry : mUpdateEntries) {
+			if ((UInt) inner[entry.first] == mUpdateColumns[i])
+				mUpdateColumn(entry.second, 0) = values[entry.first] - factorizedValues[entry.first];
+		}
+		solveInPlace(mLuFactorizationVariableSystemMatrix, mUpdateColumn, mUpdateColumnSolution, mSolveWork);
+		mUpdateSolutions.col(i) = mUpdateColumnSolution.col(0);
+	}
+	mUpdateSolutions.rightCols(mLowRankUpdateMaxRank - rank).setZero();
+
+	mUpdateCapacitanceMatrix.setIdentity();
+	for (UInt i = 0; i < rank; ++i)
+		mUpdateCapacitanceMatrix.row(i) += mUpdateSolutions.row(mUpdateColumns[i]);
+	mUpdateCapacitance.compute(mUpdateCapacitanceMatrix);
+	mUpdateSelection.setZero();
+
+	return true;
+}
+
+template <typename VarType>
+void MnaSolverEigenSparse<VarType>::applyLowRankCorrection() {
+	for (UInt i = 0; i < mUpdateColumns.size(); ++i)
+		mUpdateSelection(i, 0) = (**mLeftSideVector)(mUpdateColumns[i], 0);
+	mUpdateWeights = mUpdateCapacitance.solve(mUpdateSelection);
+	(**mLeftSideVector).noalias() -= mUpdateSolutions * mUpdateWeights;
+}
+
+template <typename VarType>
+void MnaSolverEigenSparse<VarType>::initializeSchurComplement() {
+	mSchurActive = false;
+	UInt size = mVariableSystemMatrix.rows();
+
+	// The interface are all rows and columns that switches in both states
+	// and variable elements stamp into
+	SparseMatrix probe(size, size);
+	for (auto sw : mMNAIntfSwitches)
+		sw->mnaApplySystemMatrixStamp(probe);
+	for (auto sw : mSwitches) {
+		sw->mnaApplySwitchSystemMatrixStamp(true, probe, 0);
+		sw->mnaApplySwitchSystemMatrixStamp(false, probe, 0);
+	}
+	for (auto comp : mMNAIntfVariableComps)
+		comp->mnaApplySystemMatrixStamp(probe);
+
+	std::vector<Bool> isInterface(size, false);
+	for (Int row = 0; row < probe.outerSize(); ++row) {
+		for (SparseMatrix::InnerIterator it(probe, row); it; ++it)
+			isInterface[it.row()] = isInterface[it.col()] = true;
+	}
+	for (auto& entry : mListVariableSystemMatrixEntries)
+		isInterface[entry.first] = isInterface[entry.second] = true;
+
+	// Position of each matrix index in the interior or interface block
+	std::vector<UInt> blockIdx(size);
+	mSchurInterface.clear();
+	mSchurInterior.clear();
+	for (UInt i = 0; i < size; ++i) {
+		auto& indices = isInterface[i] ? mSchurInterface : mSchurInterior;
+		blockIdx[i] = indices.size();
+		indices.push_back(i);
+	}
+	UInt numInterface = mSchurInterface.size();
+	UInt numInterior = mSchurInterior.size();
+	mSLog->info("Schur complement interface of {} of {} matrix indices", numInterface, size);
+	if (numInterior == 0 || numInterface == 0) {
+		mSLog->warn("No static interior to eliminate, Schur complement updates disabled");
+		return;
+	}
+
+	// Split the matrix into blocks, only the interface block contains variable stamps
+	std::vector<Eigen::Triplet<Real>> interior, interiorToInterface, interfaceToInterior;
+	mSchurEntries.clear();
+	const Real* values = mVariableSystemMatrix.valuePtr();
+	for (Int row = 0; row < mVariableSystemMatrix.outerSize(); ++row) {
+		for (SparseMatrix::InnerIterator it(mVariableSystemMatrix, row); it; ++it) {
+			UInt r = blockIdx[it.row()];
+			UInt c = blockIdx[it.col()];
+			Bool rowInterface = isInterface[it.row()];
+			Bool colInterface = isInterface[it.col()];
+			if (rowInterface && colInterface)
+				mSchurEntries.push_back({ r, c, static_cast<std::size_t>(&it.valueRef() - values) });
+			else if (rowInterface)
+				interfaceToInterior.emplace_back(r, c, it.value());
+			else if (colInterface)
+				interiorToInterface.emplace_back(r, c, it.value());
+			else
+				interior.emplace_back(r, c, it.value());
+		}
+	}
+
+	CPS::SparseMatrix interiorBlock(numInterior, numInterior);
+	interiorBlock.setFromTriplets(interior.begin(), interior.end());
+	CPS::SparseMatrix interiorToInterfaceBlock(numInterior, numInterface);
+	interiorToInterfaceBlock.setFromTriplets(interiorToInterface.begin(), interiorToInterface.end());
+	mSchurInterfaceToInterior = CPS::SparseMatrix(numInterface, numInterior);
+	mSchurInterfaceToInterior.setFromTriplets(interfaceToInterior.begin(), interfaceToInterior.end());
+
+	mSchurInteriorLu.analyzePattern(interiorBlock);
+	mSchurInteriorLu.factorize(interiorBlock);
+	if (mSchurInteriorLu.info() != Eigen::Success) {
+		mSLog->warn("Static interior block is singular, Schur complement updates disabled");
+		return;
+	}
+
+	// A_II^-1 A_IB and A_BI A_II^-1 A_IB do not change over time
+	mSchurCoupling = mSchurInteriorLu.solve(Matrix(interiorToInterfaceBlock));
+	mSchurStatic = mSchurInterfaceToInterior * mSchurCoupling;
+	mSchurComplement = Matrix::Zero(numInterface, numInterface);
+	mSchurInteriorRhs = Matrix::Zero(numInterior, 1);
+	mSchurInteriorVector = Matrix::Zero(numInterior, 1);
+	mSchurInteriorWork = Matrix::Zero(numInterior, 1);
+	mSchurInterfaceRhs = Matrix::Zero(numInterface, 1);
+	mSchurInterfaceVector = Matrix::Zero(numInterface, 1);
+
+	mSchurActive = true;
+	updateSchurComplement();
+}
+
+template <typename VarType>
+void MnaSolverEigenSparse<VarType>::updateSchurComplement() {
+	// S = A_BB - A_BI A_II^-1 A_IB
+	mSchurComplement = -mSchurStatic;
+	const Real* values = mVariableSystemMatrix.valuePtr();
+	for (auto& entry : mSchurEntries)
+		mSchurComplement(entry.row, entry.col) += values[entry.valueIdx];
+	mSchurLu.compute(mSchurComplement);
+}
+
+template <typename VarType>
+void MnaSolverEigenSparse<VarType>::solveSchurComplement() {
+	auto& leftVector = **mLeftSideVector;
+
+	// y_I = A_II^-1 b_I
+	for (UInt i = 0; i < mSchurInterior.size(); ++i)
+		mSchurInteriorRhs(i, 0) = mRightSideVector(mSchurInterior[i], 0);
+	solveInPlace(mSchurInteriorLu, mSchurInteriorRhs, mSchurInteriorVector, mSchurInteriorWork);
+
+	// x_B = S^-1 (b_B - A_BI y_I)
+	for (UInt i = 0; i < mSchurInterface.size(); ++i)
+		mSchurInterfaceRhs(i, 0) = mRightSideVector(mSchurInterface[i], 0);
+	mSchurInterfaceRhs.noalias() -= mSchurInterfaceToInterior * mSchurInteriorVector;
+	solveInPlace(mSchurLu, mSchurInterfaceRhs, mSchurInterfaceVector);
+
+	// x_I = y_I - A_II^-1 A_IB x_B
+	mSchurInteriorVector.noalias() -= mSchurCoupling * mSchurInterfaceVector;
+
+	for (UInt i = 0; i < mSchurInterior.size(); ++i)
+		leftVector(mSchurInterior[i], 0) = mSchurInteriorVector(i, 0);
+	for (UInt i = 0; i < mSchurInterface.size(); ++i)
+		leftVector(mSchurInterface[i], 0) = mSchurInterfaceVector(i, 0);
+}
+
 template <>
 void MnaSolverEigenSparse<Real>::createEmptySystemMatrix() {
 	if (mSwitches.size() > SWITCH_NUM)
@@ -133,7 +532,7 @@ void MnaSolverEigenSparse<Real>::createEmptySystemMatrix() {
 	if (mSystemMatrixRecomputation) {
 		mBaseSystemMatrix = SparseMatrix(mNumMatrixNodeIndices, mNumMatrixNodeIndices);
 		mVariableSystemMatrix = SparseMatrix(mNumMatrixNodeIndices, mNumMatrixNodeIndices);
-	} else {
+	} else if (!isLazySwitchFactorization()) {
 		for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++){
 			auto bit = std::bitset<SWITCH_NUM>(i);
 			mSwitchedMatrices[bit].push_back(SparseMatrix(mNumMatrixNodeIndices, mNumMatrixNodeIndices));
@@ -158,7 +557,7 @@ void MnaSolverEigenSparse<Complex>::createEmptySystemMatrix() {
 	} else if (mSystemMatrixRecomputation) {
 		mBaseSystemMatrix = SparseMatrix(2*(mNumMatrixNodeIndices), 2*(mNumMatrixNodeIndices));
 		mVariableSystemMatrix = SparseMatrix(2*(mNumMatrixNodeIndices), 2*(mNumMatrixNodeIndices));
-	} else {
+	} else if (!isLazySwitchFactorization()) {
 		for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++) {
 			auto bit = std::bitset<SWITCH_NUM>(i);
 			mSwitchedMatrices[bit].push_back(SparseMatrix(2*(mNumTotalMatrixNodeIndices), 2*(mNumTotalMatrixNodeIndices)));
@@ -191,28 +590,112 @@ std::shared_ptr<CPS::Task> MnaSolverEigenSparse<VarType>::createLogTask()
 	return std::make_shared<MnaSolverEigenSparse<VarType>::LogTask>(*this);
 }
 
+template <typename VarType>
+void MnaSolverEigenSparse<VarType>::addEnsembleMember(std::shared_ptr<MnaSolverEigenSparse<VarType>> member) {
+	if (mSystemMatrixRecomputation || mFrequencyParallel || member->mSystemMatrixRecomputation || member->mFrequencyParallel)
+		throw SystemError("Ensembles do not support system matrix recomputation or parallel frequencies");
+	if (mEnsembleLeader || !member->mEnsembleMembers.empty() || member->mEnsembleLeader)
+		throw SystemError("Solver " + member->mName + " is already part of an ensemble");
+
+	member->mEnsembleLeader = this;
+	mEnsembleMembers.push_back(member);
+}
+
+template <typename VarType>
+Task::List MnaSolverEigenSparse<VarType>::getTasks() {
+	auto tasks = MnaSolver<VarType>::getTasks();
+	if (!mEnsembleLeader)
+		return tasks;
+
+	// The solve task of the leader solves all scenarios
+	tasks.erase(std::remove_if(tasks.begin(), tasks.end(), [](const Task::Ptr& task) {
+		return std::dynamic_pointer_cast<SolveTask>(task) != nullptr;
+	}), tasks.end());
+	return tasks;
+}
+
+template <typename VarType>
+void MnaSolverEigenSparse<VarType>::warmUp() {
+	MnaSolver<VarType>::warmUp();
+
+	LUFactorizedSparse* lu = mActiveLu;
+	if (!lu && !isLazySwitchFactorization() && !mSystemMatrixRecomputation && !mFrequencyParallel) {
+		auto& luFactorizations = mEnsembleLeader ? mEnsembleLeader->mLuFactorizations : mLuFactorizations;
+		auto it = luFactorizations.find(mCurrentSwitchStatus);
+		if (it != luFactorizations.end())
+			lu = it->second[0].get();
+	}
+
+	// The solution vector is not touched, the solve writes into its own buffer
+	if (lu)
+		solveInPlace(*lu, mRightSideVector, mWarmUpVector, mSolveWork);
+}
+
+template <typename VarType>
+void MnaSolverEigenSparse<VarType>::solveEnsemble() {
+	for (UInt i = 0; i <= mEnsembleMembers.size(); ++i) {
+		auto& scenario = i == 0 ? *this : *mEnsembleMembers[i - 1];
+		scenario.mRightSideVector.setZero();
+		scenario.sumRightVectorStamps();
+		scenario.updateSwitchStatus();
+		mEnsembleRightSide.col(i) = scenario.mRightSideVector;
+	}
+
+	if (!mActiveLu || mCurrentSwitchStatus != mActiveSwitchStatus)
+		updateActiveFactorization();
+	if (!mActiveLu)
+		return;
+
+	// One solve for the right side vectors of all scenarios
+	solveInPlace(*mActiveLu, mEnsembleRightSide, mEnsembleLeftSide, mEnsembleWork);
+
+	**mLeftSideVector = mEnsembleLeftSide.col(0);
+	for (UInt i = 0; i < mEnsembleMembers.size(); ++i) {
+		auto& member = *mEnsembleMembers[i];
+		if (member.mCurrentSwitchStatus == mCurrentSwitchStatus) {
+			**member.mLeftSideVector = mEnsembleLeftSide.col(i + 1);
+			continue;
+		}
+
+		// Scenarios with another switch state are solved separately with
+		// the factorization of that state, looked up when it changes
+		if (!member.mActiveLu || member.mCurrentSwitchStatus != member.mActiveSwitchStatus) {
+			auto lu = mLuFactorizations.find(member.mCurrentSwitchStatus);
+			if (lu == mLuFactorizations.end() || lu->second.empty())
+				throw SystemError("Scenario " + member.mName + " switched to state "
+					+ member.mCurrentSwitchStatus.to_string() + ", which the ensemble has not factorized");
+			member.mActiveLu = lu->second[0].get();
+			member.mActiveSwitchStatus = member.mCurrentSwitchStatus;
+		}
+		solveInPlace(*member.mActiveLu, member.mRightSideVector, **member.mLeftSideVector, member.mSolveWork);
+	}
+}
+
 template <typename VarType>
 void MnaSolverEigenSparse<VarType>::solve(Real time, Int timeStepCount) {
+	if (!mEnsembleMembers.empty() && !mIsInInitialization) {
+		solveEnsemble();
+		return;
+	}
+
 	// Reset source vector
 	mRightSideVector.setZero();
 
 	// Add together the right side vector (computed by the components'
 	// pre-step tasks)
-	for (auto stamp : mRightVectorStamps)
-		mRightSideVector += *stamp;
+	MnaSolver<VarType>::sumRightVectorStamps();
 
 	if (!mIsInInitialization)
 		MnaSolver<VarType>::updateSwitchStatus();
 
-	if (mSwitchedMatrices.size() > 0)
-		**mLeftSideVector = mLuFactorizations[mCurrentSwitchStatus][0]->solve(mRightSideVector);
-
+	// The factorization is only looked up when the switch state changed
+	if (!mActiveLu || mCurrentSwitchStatus != mActiveSwitchStatus)
+		updateActiveFactorization();
 
-	// TODO split into separate task? (dependent on x, updating all v attributes)
-	for (UInt nodeIdx = 0; nodeIdx < mNumNetNodes; ++nodeIdx)
-		mNodes[nodeIdx]->mnaUpdateVoltage(**mLeftSideVector);
+	if (mActiveLu)
+		solveInPlace(*mActiveLu, mRightSideVector, **mLeftSideVector, mSolveWork);
 
-	// Components' states will be updated by the post-step tasks
+	// Node voltages and components' states will be updated by the post-step tasks
 }
 
 template <typename VarType>
@@ -0,0 +1,245 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/MNASolverEigenSparseComplex.h>
+
+#include <algorithm>
+#include <type_traits>
+
+using namespace DPsim;
+using namespace CPS;
+
+namespace DPsim {
+
+template <typename VarType>
+void MnaSolverEigenSparseComplex<VarType>::createEmptySystemMatrix() {
+	MnaSolverEigenSparse<VarType>::createEmptySystemMatrix();
+
+	mComplexLuFactorizations.clear();
+	mActiveComplexLu = nullptr;
+	mComplexFactorization = std::is_same<VarType, Complex>::value
+		&& !mFrequencyParallel && !mSystemMatrixRecomputation && !this->isEnsemble();
+	if (!mComplexFactorization)
+		return;
+
+	mComplexBlockSize = mNumMatrixNodeIndices;
+	mNumComplexBlocks = static_cast<UInt>(mSystem.mFrequencies.size());
+	mComplexRightSideVector = MatrixComp::Zero(mComplexBlockSize * mNumComplexBlocks, 1);
+	mComplexLeftSideVector = MatrixComp::Zero(mComplexBlockSize * mNumComplexBlocks, 1);
+	mComplexSolveWork = MatrixComp::Zero(mComplexBlockSize * mNumComplexBlocks, 1);
+	mComplexWarmUpVector = MatrixComp::Zero(mComplexBlockSize * mNumComplexBlocks, 1);
+	mSLog->info("Factorizing system matrices of dimension {} in complex arithmetic",
+		mComplexBlockSize * mNumComplexBlocks);
+}
+
+template <typename VarType>
+Bool MnaSolverEigenSparseComplex<VarType>::convertSystemMatrix(const SparseMatrix& sys, CPS::SparseMatrixComp& sysComp) {
+	// Every frequency has a block with real parts followed by imaginary parts
+	Eigen::Index size = mComplexBlockSize;
+	Eigen::Index blockSize = 2 * size;
+
+	// A complex admittance y is stamped as [Re(y) -Im(y); Im(y) Re(y)]
+	auto matches = [](Real value, Real expected) {
+		return std::abs(value - expected) <= 1e-12 * std::max(std::abs(value), std::abs(expected));
+	};
+
+	std::vector<Eigen::Triplet<Complex>> entries;
+	entries.reserve(sys.nonZeros() / 2);
+	for (Eigen::Index row = 0; row < sys.outerSize(); ++row) {
+		Eigen::Index block = row / blockSize;
+		Eigen::Index rowIdx = row % blockSize;
+		for (SparseMatrix::InnerIterator it(sys, row); it; ++it) {
+			if (it.col() / blockSize != block)
+				return false;
+			Eigen::Index colIdx = it.col() % blockSize;
+			Bool realCol = colIdx < size;
+
+			// Entries of the lower rows must be mirrored in the upper rows
+			// and the other way round
+			Real mirrored;
+			if (rowIdx < size)
+				mirrored = realCol ? sys.coeff(row + size, it.col() + size) : -sys.coeff(row + size, it.col() - size);
+			else
+				mirrored = realCol ? -sys.coeff(row - size, it.col() + size) : sys.coeff(row - size, it.col() - size);
+			if (!matches(it.value(), mirrored))
+				return false;
+
+			if (rowIdx >= size)
+				continue;
+			Eigen::Index compRow = block * size + rowIdx;
+			if (realCol)
+				entries.emplace_back(compRow, block * size + colIdx, Complex(it.value(), 0));
+			else
+				entries.emplace_back(compRow, block * size + colIdx - size, Complex(0, -it.value()));
+		}
+	}
+
+	sysComp = CPS::SparseMatrixComp(size * mNumComplexBlocks, size * mNumComplexBlocks);
+	sysComp.setFromTriplets(entries.begin(), entries.end());
+	sysComp.makeCompressed();
+	return true;
+}
+
+template <typename VarType>
+void MnaSolverEigenSparseComplex<VarType>::useRealFactorization() {
+	mSLog->warn("System matrix contains stamps that are not complex admittances, "
+		"falling back to the real factorization");
+	mComplexFactorization = false;
+
+	for (auto& lu : mComplexLuFactorizations) {
+		auto& sys = mSwitchedMatrices[lu.first][0];
+		sys.setZero();
+		MnaSolverEigenSparse<VarType>::switchedMatrixStamp(lu.first.to_ullong(), mMNAComponents);
+
+		// Cached states are accounted with the size of the real factorization now
+		auto bytes = mSwitchCacheEntryBytes.find(lu.first);
+		if (bytes != mSwitchCacheEntryBytes.end()) {
+			mSwitchCacheBytes -= bytes->second;
+			bytes->second = switchMatrixBytes(lu.first);
+			mSwitchCacheBytes += bytes->second;
+		}
+	}
+	mComplexLuFactorizations.clear();
+	mActiveComplexLu = nullptr;
+}
+
+template <typename VarType>
+void MnaSolverEigenSparseComplex<VarType>::switchedMatrixStamp(std::size_t index, std::vector<std::shared_ptr<CPS::MNAInterface>>& comp) {
+	if (!mComplexFactorization) {
+		MnaSolverEigenSparse<VarType>::switchedMatrixStamp(index, comp);
+		return;
+	}
+
+	auto bit = std::bitset<SWITCH_NUM>(index);
+	auto& sys = mSwitchedMatrices[bit][0];
+	for (auto comp : comp) {
+		comp->mnaApplySystemMatrixStamp(sys);
+	}
+	for (UInt i = 0; i < mSwitches.size(); ++i)
+		mSwitches[i]->mnaApplySwitchSystemMatrixStamp(bit[i], sys, 0);
+
+	CPS::SparseMatrixComp sysComp;
+	if (!convertSystemMatrix(sys, sysComp)) {
+		useRealFactorization();
+		mLuFactorizations[bit][0]->analyzePattern(sys);
+		mLuFactorizations[bit][0]->factorize(sys);
+		return;
+	}
+
+	// Compute LU-factorization for complex system matrix
+	auto& lu = mComplexLuFactorizations[bit];
+	if (!lu)
+		lu = std::make_shared<LUFactorizedSparseComp>();
+	lu->analyzePattern(sysComp);
+	lu->factorize(sysComp);
+
+	// Only the complex form is needed for the solves, the real matrix is
+	// stamped again if the solver falls back to the real factorization
+	SparseMatrix(sys.rows(), sys.cols()).swap(sys);
+}
+
+template <typename VarType>
+void MnaSolverEigenSparseComplex<VarType>::evictSwitchMatrices() {
+	MnaSolverEigenSparse<VarType>::evictSwitchMatrices();
+
+	for (auto it = mComplexLuFactorizations.begin(); it != mComplexLuFactorizations.end();) {
+		if (mSwitchCachePositions.find(it->first) == mSwitchCachePositions.end())
+			it = mComplexLuFactorizations.erase(it);
+		else
+			++it;
+	}
+}
+
+template <typename VarType>
+std::size_t MnaSolverEigenSparseComplex<VarType>::switchMatrixBytes(const std::bitset<SWITCH_NUM>& status) {
+	if (!mComplexFactorization)
+		return MnaSolverEigenSparse<VarType>::switchMatrixBytes(status);
+
+	auto& lu = mComplexLuFactorizations[status];
+	return mSwitchedMatrices[status][0].nonZeros() * (sizeof(Real) + sizeof(SparseMatrix::StorageIndex))
+		+ (lu->nnzL() + lu->nnzU()) * (sizeof(Complex) + sizeof(CPS::SparseMatrixComp::StorageIndex));
+}
+
+template <typename VarType>
+void MnaSolverEigenSparseComplex<VarType>::updateActiveFactorization() {
+	MnaSolverEigenSparse<VarType>::updateActiveFactorization();
+
+	// Activating a switch state may have fallen back to the real factorization
+	if (mComplexFactorization)
+		mActiveComplexLu = mComplexLuFactorizations[mActiveSwitchStatus].get();
+}
+
+template <typename VarType>
+void MnaSolverEigenSparseComplex<VarType>::solve(Real time, Int timeStepCount) {
+	if (!mComplexFactorization) {
+		MnaSolverEigenSparse<VarType>::solve(time, timeStepCount);
+		return;
+	}
+
+	// Reset source vector
+	mRightSideVector.setZero();
+
+	// Add together the right side vector (computed by the components'
+	// pre-step tasks)
+	MnaSolver<VarType>::sumRightVectorStamps();
+
+	if (!mIsInInitialization)
+		MnaSolver<VarType>::updateSwitchStatus();
+
+	if (!mActiveComplexLu || mCurrentSwitchStatus != mActiveSwitchStatus)
+		updateActiveFactorization();
+
+	if (!mComplexFactorization) {
+		solveInPlace(*mActiveLu, mRightSideVector, **mLeftSideVector, mSolveWork);
+		return;
+	}
+
+	// Map real and imaginary parts to complex unknowns and back
+	auto& leftVector = **mLeftSideVector;
+	for (UInt block = 0; block < mNumComplexBlocks; ++block) {
+		UInt offset = 2 * block * mComplexBlockSize;
+		for (UInt i = 0; i < mComplexBlockSize; ++i)
+			mComplexRightSideVector(block * mComplexBlockSize + i, 0) = Complex(
+				mRightSideVector(offset + i, 0), mRightSideVector(offset + mComplexBlockSize + i, 0));
+	}
+
+	solveInPlace(*mActiveComplexLu, mComplexRightSideVector, mComplexLeftSideVector, mComplexSolveWork);
+
+	for (UInt block = 0; block < mNumComplexBlocks; ++block) {
+		UInt offset = 2 * block * mComplexBlockSize;
+		for (UInt i = 0; i < mComplexBlockSize; ++i) {
+			leftVector(offset + i, 0) = mComplexLeftSideVector(block * mComplexBlockSize + i, 0).real();
+			leftVector(offset + mComplexBlockSize + i, 0) = mComplexLeftSideVector(block * mComplexBlockSize + i, 0).imag();
+		}
+	}
+
+	// Node voltages and components' states will be updated by the post-step tasks
+}
+
+template <typename VarType>
+void MnaSolverEigenSparseComplex<VarType>::warmUp() {
+	if (!mComplexFactorization) {
+		MnaSolverEigenSparse<VarType>::warmUp();
+		return;
+	}
+	MnaSolver<VarType>::warmUp();
+
+	CPS::LUFactorizedSparseComp* lu = mActiveComplexLu;
+	if (!lu && !isLazySwitchFactorization()) {
+		auto it = mComplexLuFactorizations.find(mCurrentSwitchStatus);
+		if (it != mComplexLuFactorizations.end())
+			lu = it->second.get();
+	}
+	if (lu)
+		solveInPlace(*lu, mComplexRightSideVector, mComplexWarmUpVector, mComplexSolveWork);
+}
+
+}
+
+template class DPsim::MnaSolverEigenSparseComplex<Real>;
+template class DPsim::MnaSolverEigenSparseComplex<Complex>;
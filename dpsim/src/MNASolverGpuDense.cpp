@@ -20,6 +20,9 @@ MnaSolverGpuDense<VarType>::MnaSolverGpuDense(String name,
     MnaSolverEigenDense<VarType>(name, domain, logLevel),
     mCusolverHandle(nullptr), mStream(nullptr) {
 
+    // Node voltages are updated by the solve task
+    this->mNodeVoltageTasks = false;
+
     mDeviceCopy = {};
 
     cusolverStatus_t status = CUSOLVER_STATUS_SUCCESS;
@@ -167,8 +170,7 @@ void MnaSolverGpuDense<VarType>::solve(Real time, Int timeStepCount) {
 
     // Add together the right side vector (computed by the components'
 	// pre-step tasks)
-	for (const auto &stamp : this->mRightVectorStamps)
-		this->mRightSideVector += *stamp;
+	this->sumRightVectorStamps();
 
     if (!this->mIsInInitialization)
 		this->updateSwitchStatus();
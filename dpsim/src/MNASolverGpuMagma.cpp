@@ -22,6 +22,8 @@ MnaSolverGpuMagma<VarType>::MnaSolverGpuMagma(String name,
 	CPS::Domain domain, CPS::Logger::Level logLevel) :
     MnaSolverEigenSparse<VarType>(name, domain, logLevel)
 {
+	// Node voltages are updated by the solve task
+	this->mNodeVoltageTasks = false;
 	magma_init();
 	magma_queue_create(0, &mMagmaQueue);
 	mHostSysMat = {Magma_CSR};
@@ -156,8 +158,7 @@ void MnaSolverGpuMagma<VarType>::solve(Real time, Int timeStepCount) {
 
     // Add together the right side vector (computed by the components'
 	// pre-step tasks)
-	for (const auto &stamp : this->mRightVectorStamps)
-		this->mRightSideVector += *stamp;
+	this->sumRightVectorStamps();
 
 	if (!this->mIsInInitialization)
 		this->updateSwitchStatus();
@@ -26,6 +26,8 @@ MnaSolverGpuSparse<VarType>::MnaSolverGpuSparse(String name,
 	mGpuRhsVec(0), mGpuLhsVec(0), mGpuIntermediateVec(0),
 	pBuffer(0) {
 
+	// Node voltages are updated by the solve task
+	this->mNodeVoltageTasks = false;
 }
 
 template <typename VarType>
@@ -247,8 +249,7 @@ void MnaSolverGpuSparse<VarType>::solve(Real time, Int timeStepCount) {
 
     // Add together the right side vector (computed by the components'
 	// pre-step tasks)
-	for (const auto &stamp : this->mRightVectorStamps)
-		this->mRightSideVector += *stamp;
+	this->sumRightVectorStamps();
 
 	if (!this->mIsInInitialization)
 		this->updateSwitchStatus();
@@ -0,0 +1,252 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/MNASolverLeftLookingSparse.h>
+
+using namespace DPsim;
+using namespace CPS;
+
+namespace DPsim {
+
+template <typename VarType>
+void MnaSolverLeftLookingSparse<VarType>::createEmptySystemMatrix() {
+	MnaSolverEigenSparse<VarType>::createEmptySystemMatrix();
+
+	mLeftLookingLus.clear();
+	mColumnMatrices.clear();
+	mActiveLeftLookingLu = nullptr;
+	mLeftLookingFactorization = !mFrequencyParallel && !this->isEnsemble();
+}
+
+template <typename VarType>
+void MnaSolverLeftLookingSparse<VarType>::initializeSystemWithPrecomputedMatrices() {
+	mActiveLeftLookingLu = nullptr;
+	if (this->isLazySwitchFactorization()) {
+		mLeftLookingLus.clear();
+		mColumnMatrices.clear();
+	}
+	MnaSolverEigenSparse<VarType>::initializeSystemWithPrecomputedMatrices();
+}
+
+template <typename VarType>
+void MnaSolverLeftLookingSparse<VarType>::switchedMatrixStamp(std::size_t index, std::vector<std::shared_ptr<CPS::MNAInterface>>& comp) {
+	if (!mLeftLookingFactorization) {
+		MnaSolverEigenSparse<VarType>::switchedMatrixStamp(index, comp);
+		return;
+	}
+
+	auto bit = std::bitset<SWITCH_NUM>(index);
+	auto& sys = mSwitchedMatrices[bit][0];
+	for (auto comp : comp) {
+		comp->mnaApplySystemMatrixStamp(sys);
+	}
+	for (UInt i = 0; i < mSwitches.size(); ++i)
+		mSwitches[i]->mnaApplySwitchSystemMatrixStamp(bit[i], sys, 0);
+
+	auto& cols = mColumnMatrices[bit];
+	cols = sys;
+	cols.makeCompressed();
+
+	// Switch states usually share the pattern and only differ in the columns
+	// of the switches, so the factorization of the active or any other state
+	// is copied and refactorized from the first differing column on
+	auto ref = mLeftLookingLus.find(mActiveSwitchStatus);
+	if (ref == mLeftLookingLus.end() || ref->first == bit)
+		ref = mLeftLookingLus.begin();
+	if (ref != mLeftLookingLus.end() && ref->first != bit && ref->second->hasPattern(cols)) {
+		const auto& refCols = mColumnMatrices[ref->first];
+		std::vector<UInt> changed;
+		for (Int col = 0; col < cols.outerSize(); ++col) {
+			for (Int p = cols.outerIndexPtr()[col]; p < cols.outerIndexPtr()[col + 1]; ++p) {
+				if (cols.valuePtr()[p] != refCols.valuePtr()[p]) {
+					changed.push_back(col);
+					break;
+				}
+			}
+		}
+
+		auto lu = std::make_shared<LeftLookingLU>(*ref->second);
+		if (lu->refactorize(cols, changed)) {
+			mSLog->debug("Refactorized {} of {} columns for switch state {:s}",
+				lu->lastRefactorizedColumns(), lu->rows(), bit.to_string());
+			mLeftLookingLus[bit] = lu;
+			return;
+		}
+	}
+
+	auto lu = std::make_shared<LeftLookingLU>();
+	lu->factorize(cols);
+	mLeftLookingLus[bit] = lu;
+}
+
+template <typename VarType>
+void MnaSolverLeftLookingSparse<VarType>::evictSwitchMatrices() {
+	MnaSolverEigenSparse<VarType>::evictSwitchMatrices();
+
+	for (auto it = mLeftLookingLus.begin(); it != mLeftLookingLus.end();) {
+		if (mSwitchCachePositions.find(it->first) == mSwitchCachePositions.end()) {
+			mColumnMatrices.erase(it->first);
+			it = mLeftLookingLus.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
+template <typename VarType>
+std::size_t MnaSolverLeftLookingSparse<VarType>::switchMatrixBytes(const std::bitset<SWITCH_NUM>& status) {
+	if (!mLeftLookingFactorization)
+		return MnaSolverEigenSparse<VarType>::switchMatrixBytes(status);
+
+	// The matrix is kept in row-major and column-major form
+	std::size_t nonZeros = 2 * mSwitchedMatrices[status][0].nonZeros() + mLeftLookingLus[status]->nonZeros();
+	return nonZeros * (sizeof(Real) + sizeof(Int));
+}
+
+template <typename VarType>
+void MnaSolverLeftLookingSparse<VarType>::updateActiveFactorization() {
+	MnaSolverEigenSparse<VarType>::updateActiveFactorization();
+
+	auto lu = mLeftLookingLus.find(mActiveSwitchStatus);
+	mActiveLeftLookingLu = lu != mLeftLookingLus.end() ? lu->second.get() : nullptr;
+}
+
+template <typename VarType>
+void MnaSolverLeftLookingSparse<VarType>::solve(Real time, Int timeStepCount) {
+	if (!mLeftLookingFactorization) {
+		MnaSolverEigenSparse<VarType>::solve(time, timeStepCount);
+		return;
+	}
+
+	// Reset source vector
+	mRightSideVector.setZero();
+
+	// Add together the right side vector (computed by the components'
+	// pre-step tasks)
+	MnaSolver<VarType>::sumRightVectorStamps();
+
+	if (!mIsInInitialization)
+		MnaSolver<VarType>::updateSwitchStatus();
+
+	// The factorization is only looked up when the switch state changed
+	if (!mActiveLeftLookingLu || mCurrentSwitchStatus != mActiveSwitchStatus)
+		updateActiveFactorization();
+
+	if (mActiveLeftLookingLu)
+		mActiveLeftLookingLu->solveInPlace(mRightSideVector, **mLeftSideVector);
+
+	// Node voltages and components' states will be updated by the post-step tasks
+}
+
+template <typename VarType>
+void MnaSolverLeftLookingSparse<VarType>::stampVariableSystemMatrix() {
+	MnaSolverEigenSparse<VarType>::stampVariableSystemMatrix();
+	if (!mLeftLookingFactorization)
+		return;
+
+	if (mLowRankUpdates || mSchurComplementUpdates)
+		mSLog->info("Low-rank and Schur complement updates are replaced by partial refactorization");
+	mSchurActive = false;
+	mUpdateColumns.clear();
+
+	factorizeVariableSystemMatrix();
+}
+
+template <typename VarType>
+void MnaSolverLeftLookingSparse<VarType>::factorizeVariableSystemMatrix() {
+	mVariableColumnMatrix = mVariableSystemMatrix;
+	mVariableColumnMatrix.makeCompressed();
+
+	// The variable system matrix is compressed, so its values are indexed directly
+	const Int* outer = mVariableSystemMatrix.outerIndexPtr();
+	const Int* inner = mVariableSystemMatrix.innerIndexPtr();
+	const Real* colValues = mVariableColumnMatrix.valuePtr();
+	mColumnValueIdx.resize(mVariableSystemMatrix.nonZeros());
+	for (Int row = 0; row < mVariableSystemMatrix.outerSize(); ++row) {
+		for (Int p = outer[row]; p < outer[row + 1]; ++p)
+			mColumnValueIdx[p] = static_cast<Int>(&mVariableColumnMatrix.coeffRef(row, inner[p]) - colValues);
+	}
+
+	mChangedColumns.clear();
+	mChangedColumns.reserve(mVariableColumnMatrix.cols());
+	mColumnChanged.assign(mVariableColumnMatrix.cols(), false);
+
+	mVariableLu.factorize(mVariableColumnMatrix);
+	mSLog->info("Variable system matrix has {} blocks and {} non-zeros in its factors",
+		mVariableLu.numBlocks(), mVariableLu.nonZeros());
+}
+
+template <typename VarType>
+void MnaSolverLeftLookingSparse<VarType>::recomputeSystemMatrix(Real time) {
+	if (!mLeftLookingFactorization) {
+		MnaSolverEigenSparse<VarType>::recomputeSystemMatrix(time);
+		return;
+	}
+
+	if (restampVariableSystemMatrix()) {
+		factorizeVariableSystemMatrix();
+		mNumRefactorizedColumns += mVariableLu.rows();
+		++mNumRecomputations;
+		return;
+	}
+
+	// Copy changed values into the column-major matrix and collect their columns
+	const Int* inner = mVariableSystemMatrix.innerIndexPtr();
+	const Real* values = mVariableSystemMatrix.valuePtr();
+	Real* colValues = mVariableColumnMatrix.valuePtr();
+	for (Int p = 0; p < mVariableSystemMatrix.nonZeros(); ++p) {
+		Real& value = colValues[mColumnValueIdx[p]];
+		if (value == values[p])
+			continue;
+		value = values[p];
+		if (!mColumnChanged[inner[p]]) {
+			mColumnChanged[inner[p]] = true;
+			mChangedColumns.push_back(inner[p]);
+		}
+	}
+	if (mChangedColumns.empty())
+		return;
+
+	// Pivots that became too small require a factorization with new pivots
+	if (!mVariableLu.refactorize(mVariableColumnMatrix, mChangedColumns))
+		mVariableLu.factorize(mVariableColumnMatrix);
+	mNumRefactorizedColumns += mVariableLu.lastRefactorizedColumns();
+
+	for (UInt col : mChangedColumns)
+		mColumnChanged[col] = false;
+	mChangedColumns.clear();
+	++mNumRecomputations;
+}
+
+template <typename VarType>
+void MnaSolverLeftLookingSparse<VarType>::solveWithSystemMatrixRecomputation(Real time, Int timeStepCount) {
+	if (!mLeftLookingFactorization) {
+		MnaSolverEigenSparse<VarType>::solveWithSystemMatrixRecomputation(time, timeStepCount);
+		return;
+	}
+
+	// Reset source vector
+	mRightSideVector.setZero();
+
+	// Add together the right side vector (computed by the components'
+	// pre-step tasks)
+	MnaSolver<VarType>::sumRightVectorStamps();
+
+	// Get switch and variable comp status and update system matrix and lu factorization accordingly
+	if (hasVariableComponentChanged())
+		recomputeSystemMatrix(time);
+
+	mVariableLu.solveInPlace(mRightSideVector, **mLeftSideVector);
+
+	// Node voltages and components' states will be updated by the post-step tasks
+}
+
+}
+
+template class DPsim::MnaSolverLeftLookingSparse<Real>;
+template class DPsim::MnaSolverLeftLookingSparse<Complex>;
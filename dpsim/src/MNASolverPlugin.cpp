@@ -25,6 +25,8 @@ MnaSolverPlugin<VarType>::MnaSolverPlugin(String pluginName,
 	mPlugin(nullptr),
 	mDlHandle(nullptr)
 {
+	// Node voltages are updated by the solve task
+	this->mNodeVoltageTasks = false;
 }
 
 template <typename VarType>
@@ -45,16 +47,9 @@ extern "C" void pluginLogger(const char * str)
 
 template <typename VarType>
 void MnaSolverPlugin<VarType>::recomputeSystemMatrix(Real time) {
-	// Start from base matrix
-	this->mVariableSystemMatrix = this->mBaseSystemMatrix;
-
-	// Now stamp switches into matrix
-	for (auto sw : this->mMNAIntfSwitches)
-		sw->mnaApplySparseSystemMatrixStamp(this->mVariableSystemMatrix);
-
-	// Now stamp variable elements into matrix
-	for (auto comp : this->mMNAIntfVariableComps)
-		comp->mnaApplySparseSystemMatrixStamp(this->mVariableSystemMatrix);
+	// Restamp in place on the union sparsity pattern
+	if (this->restampVariableSystemMatrix())
+		mSLog->warn("Plugin decomposition assumes a constant sparsity pattern");
 
     int size = this->mRightSideVector.rows();
 	int nnz = this->mVariableSystemMatrix.nonZeros();
@@ -148,8 +143,7 @@ void MnaSolverPlugin<VarType>::solve(Real time, Int timeStepCount) {
 
     // Add together the right side vector (computed by the components'
 	// pre-step tasks)
-	for (const auto &stamp : this->mRightVectorStamps)
-		this->mRightSideVector += *stamp;
+	this->sumRightVectorStamps();
 
 	if (!this->mIsInInitialization)
 		this->updateSwitchStatus();
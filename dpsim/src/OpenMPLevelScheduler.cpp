@@ -27,8 +27,14 @@ void OpenMPLevelScheduler::createSchedule(const Task::List& tasks, const Edges&
 	Scheduler::topologicalSort(tasks, inEdges, outEdges, ordered);
 	Scheduler::levelSchedule(ordered, inEdges, outEdges, mLevels);
 
-	if (!mOutMeasurementFile.empty())
+	if (!mOutMeasurementFile.empty()) {
 		Scheduler::initMeasurements(tasks);
+		mLevelMeasurements.assign(mLevels.size(), std::vector<UInt>());
+		for (size_t level = 0; level < mLevels.size(); level++) {
+			for (auto task : mLevels[level])
+				mLevelMeasurements[level].push_back(measurementIndex(task.get()));
+		}
+	}
 }
 
 void OpenMPLevelScheduler::step(Real time, Int timeStepCount) {
@@ -44,7 +50,7 @@ void OpenMPLevelScheduler::step(Real time, Int timeStepCount) {
 					start = std::chrono::steady_clock::now();
 					mLevels[level][i]->execute(time, timeStepCount);
 					end = std::chrono::steady_clock::now();
-					updateMeasurement(mLevels[level][i].get(), end-start);
+					updateMeasurement(mLevelMeasurements[level][i], end-start);
 				}
 			}
 		}
@@ -48,7 +48,18 @@ void PFSolver::initialize(){
 	determineNodeBaseVoltages();
     composeAdmittanceMatrix();
 
-	mJ.setZero(mNumUnknowns,mNumUnknowns);
+	// Reserve the Jacobian pattern from the admittance matrix,
+	// each bus contributes up to two entries per admittance
+	Eigen::VectorXi admittancesPerColumn = Eigen::VectorXi::Zero(mNumUnknowns);
+	for (UInt a = 0; a < mPQPVBusIndices.size(); ++a) {
+		Int nnz = mY.innerVector(mPQPVBusIndices[a]).nonZeros();
+		admittancesPerColumn(a) = 2 * nnz;
+		if (a < mNumPQBuses)
+			admittancesPerColumn(a + mPQPVBusIndices.size()) = 2 * nnz;
+	}
+	mJ = CPS::SparseMatrix(mNumUnknowns, mNumUnknowns);
+	mJ.reserve(admittancesPerColumn);
+	mJPatternAnalyzed = false;
 	mX.setZero(mNumUnknowns);
 	mF.setZero(mNumUnknowns);
 }
@@ -215,6 +226,12 @@ void PFSolver::determinePFBusType() {
     mPQPVBusIndices.insert(mPQPVBusIndices.end(), mPQBusIndices.begin(), mPQBusIndices.end());
     mPQPVBusIndices.insert(mPQPVBusIndices.end(), mPVBusIndices.begin(), mPVBusIndices.end());
 
+	// The bus types do not change afterwards, so the Jacobian looks up
+	// the positions from here
+	mPQPVBusPositions.assign(mSystem.mNodes.size(), -1);
+	for (UInt a = 0; a < mPQPVBusIndices.size(); ++a)
+		mPQPVBusPositions[mPQPVBusIndices[a]] = a;
+
 	mSLog->info("#### Create index vectors for power flow solver:");
     mSLog->info("PQ Buses: {}", logVector(mPQBusIndices));
     mSLog->info("PV Buses: {}", logVector(mPVBusIndices));
@@ -373,12 +390,18 @@ Bool PFSolver::solvePowerflow() {
     for (unsigned i = 1; i < mMaxIterations && !isConverged; ++i) {
 
         calculateJacobian();
-		auto sparseJ = mJ.sparseView();
 
-		// Solve system mJ*mX = mF
-        Eigen::SparseLU<SparseMatrix>lu(sparseJ);
+		// The Jacobian pattern follows the admittance matrix and does not change,
+		// so its symbolic analysis is reused over iterations and time steps
+		if (!mJPatternAnalyzed) {
+			mJ.makeCompressed();
+			mJLU.analyzePattern(mJ);
+			mJPatternAnalyzed = true;
+		}
+		mJLU.factorize(mJ);
 
-		mX = lu.solve(mF);	/* code */
+		// Solve system mJ*mX = mF
+		mX = mJLU.solve(mF);
 
 		// Calculate new solution based on mX increments obtained from equation system
 		updateSolution();
@@ -37,8 +37,8 @@ void PFSolverPowerPolar::generateInitialSolution(Real time, bool keep_last_solut
 		}
 		for (auto comp : mSystem.mComponentsAtNode[pq]) {
             if (std::shared_ptr<CPS::SP::Ph1::Load> load = std::dynamic_pointer_cast<CPS::SP::Ph1::Load>(comp)) {
-                sol_P(pq->matrixNodeIndex()) -= load->attributeTyped<CPS::Real>("P_pu")->get();
-                sol_Q(pq->matrixNodeIndex()) -= load->attributeTyped<CPS::Real>("Q_pu")->get();
+                sol_P(pq->matrixNodeIndex()) -= **load->mActivePowerPerUnit;
+                sol_Q(pq->matrixNodeIndex()) -= **load->mReactivePowerPerUnit;
             }
             else if(std::shared_ptr<CPS::SP::Ph1::SolidStateTransformer> sst =
                 std::dynamic_pointer_cast<CPS::SP::Ph1::SolidStateTransformer>(comp)){
@@ -140,100 +140,54 @@ void PFSolverPowerPolar::calculateMismatch() {
 
 void PFSolverPowerPolar::calculateJacobian() {
     UInt npqpv = mNumPQBuses + mNumPVBuses;
-    double val;
+    Real valSin, valCos;
     UInt k, j;
-    UInt da, db;
+    Int b;
 
-    mJ.setZero();
+    // Keep the sparsity pattern and only reset its values,
+    // the pattern is only uncompressed before the first assembly
+    if (mJ.isCompressed())
+        mJ.coeffs().setZero();
 
-    //J1
+    // Submatrices J1 (dP/dD), J2 (dP/dV * V), J3 (dQ/dD) and J4 (dQ/dV * V),
+    // J2 and J4 only have columns and J3 and J4 only rows for PQ buses
     for (UInt a = 0; a < npqpv; ++a) { //rows
         k = mPQPVBusIndices[a];
-        //diagonal
-        mJ.coeffRef(a, a) = -Q(k) - B(k, k) * sol_V.coeff(k) * sol_V.coeff(k);
-
-        //non diagonal elements
-        for (UInt b = 0; b < npqpv; ++b) {
-            if (b != a) {
-                j = mPQPVBusIndices[b];
-                val = sol_V.coeff(k) * sol_V.coeff(j)
-                        *(G(k, j) * sin(sol_D.coeff(k) - sol_D.coeff(j))
-                        - B(k, j) * cos(sol_D.coeff(k) - sol_D.coeff(j)));
-                //if (val != 0.0)
-                mJ.coeffRef(a, b) = val;
-            }
-        }
-    }
+        Real Pk = P(k);
+        Real Qk = Q(k);
+        Real Vk2 = sol_V.coeff(k) * sol_V.coeff(k);
 
-    //J2
-    da = 0;
-    db = npqpv;
-    for (UInt a = 0; a < npqpv; ++a) { //rows
-        k = mPQPVBusIndices[a];
         //diagonal
-        //std::cout << "J2D:" << (a + da) << "," << (a + db) << std::endl;
-        if (a < mNumPQBuses)
-            mJ.coeffRef(a + da, a + db) = P(k) + G(k, k) * sol_V.coeff(k) * sol_V.coeff(k);
-
-        //non diagonal elements
-        for (UInt b = 0; b < mNumPQBuses; ++b) {
-            if (b != a) {
-                j = mPQPVBusIndices[b];
-                val = sol_V.coeff(k) * sol_V.coeff(j)
-                        *(G(k, j) * cos(sol_D.coeff(k) - sol_D.coeff(j))
-                        + B(k, j) * sin(sol_D.coeff(k) - sol_D.coeff(j)));
-                //if (val != 0.0)
-                //std::cout << "J2ij:" << (a + da) << "," << (b + db) << std::endl;
-                mJ.coeffRef(a + da, b + db) = val;
-            }
+        mJ.coeffRef(a, a) = -Qk - B(k, k) * Vk2;
+        if (a < mNumPQBuses) {
+            mJ.coeffRef(a, a + npqpv) = Pk + G(k, k) * Vk2;
+            mJ.coeffRef(a + npqpv, a) = Pk - G(k, k) * Vk2;
+            mJ.coeffRef(a + npqpv, a + npqpv) = Qk - B(k, k) * Vk2;
         }
-    }
-
 
-    //J3
-    da = npqpv;
-    db = 0;
-    for (UInt a = 0; a < mNumPQBuses; ++a) { //rows
-        k = mPQPVBusIndices[a];
-        //diagonal
-        //std::cout << "J3:" << (a + da) << "," << (a + db) << std::endl;
-        mJ.coeffRef(a + da, a + db) = P(k) - G(k, k) * sol_V.coeff(k) * sol_V.coeff(k);
-
-        //non diagonal elements
-        for (UInt b = 0; b < npqpv; ++b) {
-            if (b != a) {
-                j = mPQPVBusIndices[b];
-                val = sol_V.coeff(k) * sol_V.coeff(j)
-                        *(G(k, j) * cos(sol_D.coeff(k) - sol_D.coeff(j))
-                        + B(k, j) * sin(sol_D.coeff(k) - sol_D.coeff(j)));
-                //if (val != 0.0)
-                //std::cout << "J3:" << (a + da) << "," << (b + db) << std::endl;
-                mJ.coeffRef(a + da, b + db) = -val;
-            }
-        }
-    }
-
-    //J4
-    da = npqpv;
-    db = npqpv;
-    for (UInt a = 0; a < mNumPQBuses; ++a) { //rows
-        k = mPQPVBusIndices[a];
-        //diagonal
-        //std::cout << "J4:" << (a + da) << "," << (a + db) << std::endl;
-        mJ.coeffRef(a + da, a + db) = Q(k) - B(k, k) * sol_V.coeff(k) * sol_V.coeff(k);
-
-        //non diagonal elements
-        for (UInt b = 0; b < mNumPQBuses; ++b) {
-            if (b != a) {
-                j = mPQPVBusIndices[b];
-                val = sol_V.coeff(k) * sol_V.coeff(j)
-                        *(G(k, j) * sin(sol_D.coeff(k) - sol_D.coeff(j))
-                        - B(k, j) * cos(sol_D.coeff(k) - sol_D.coeff(j)));
-                if (val != 0.0) {
-                    //std::cout << "J4:" << (a + da) << "," << (b + db) << std::endl;
-                    mJ.coeffRef(a + da, b + db) = val;
-                }
-            }
+        //non diagonal elements only where the admittance matrix has entries
+        for (SparseMatrixCompRow::InnerIterator it(mY, k); it; ++it) {
+            j = it.col();
+            b = mPQPVBusPositions[j];
+            if (b < 0 || (UInt) b == a)
+                continue;
+
+            Real Gkj = it.value().real();
+            Real Bkj = it.value().imag();
+            valSin = sol_V.coeff(k) * sol_V.coeff(j)
+                    *(Gkj * sin(sol_D.coeff(k) - sol_D.coeff(j))
+                    - Bkj * cos(sol_D.coeff(k) - sol_D.coeff(j)));
+            valCos = sol_V.coeff(k) * sol_V.coeff(j)
+                    *(Gkj * cos(sol_D.coeff(k) - sol_D.coeff(j))
+                    + Bkj * sin(sol_D.coeff(k) - sol_D.coeff(j)));
+
+            mJ.coeffRef(a, b) = valSin;
+            if ((UInt) b < mNumPQBuses)
+                mJ.coeffRef(a, b + npqpv) = valCos;
+            if (a < mNumPQBuses)
+                mJ.coeffRef(a + npqpv, b) = -valCos;
+            if (a < mNumPQBuses && (UInt) b < mNumPQBuses)
+                mJ.coeffRef(a + npqpv, b + npqpv) = valSin;
         }
     }
 }
@@ -334,20 +288,22 @@ void PFSolverPowerPolar::calculateNodalInjection() {
 
 Real PFSolverPowerPolar::P(UInt k) {
     Real val = 0.0;
-    for (UInt j = 0; j < mSystem.mNodes.size(); ++j) {
+    for (SparseMatrixCompRow::InnerIterator it(mY, k); it; ++it) {
+        UInt j = it.col();
         val += sol_V.coeff(j)
-                *(G(k, j) * cos(sol_D.coeff(k) - sol_D.coeff(j))
-                + B(k, j) * sin(sol_D.coeff(k) - sol_D.coeff(j)));
+                *(it.value().real() * cos(sol_D.coeff(k) - sol_D.coeff(j))
+                + it.value().imag() * sin(sol_D.coeff(k) - sol_D.coeff(j)));
     }
     return sol_V.coeff(k) * val;
 }
 
 Real PFSolverPowerPolar::Q(UInt k) {
     Real val = 0.0;
-    for (UInt j = 0; j < mSystem.mNodes.size(); ++j) {
+    for (SparseMatrixCompRow::InnerIterator it(mY, k); it; ++it) {
+        UInt j = it.col();
         val += sol_V.coeff(j)
-                *(G(k, j) * sin(sol_D.coeff(k) - sol_D.coeff(j))
-                - B(k, j) * cos(sol_D.coeff(k) - sol_D.coeff(j)));
+                *(it.value().real() * sin(sol_D.coeff(k) - sol_D.coeff(j))
+                - it.value().imag() * cos(sol_D.coeff(k) - sol_D.coeff(j)));
     }
     return sol_V.coeff(k) * val;
 }
@@ -355,8 +311,8 @@ Real PFSolverPowerPolar::Q(UInt k) {
 void PFSolverPowerPolar::calculatePAndQAtSlackBus() {
     for (auto k: mVDBusIndices) {
         CPS::Complex I(0.0, 0.0);
-        for (UInt j = 0; j < mSystem.mNodes.size(); ++j) {
-            I += mY.coeff(k, j) * sol_Vcx(j);
+        for (SparseMatrixCompRow::InnerIterator it(mY, k); it; ++it) {
+            I += it.value() * sol_Vcx(it.col());
         }
         CPS::Complex S(0.0, 0.0);
         S = sol_Vcx(k) * conj(I);
@@ -380,8 +336,8 @@ void PFSolverPowerPolar::calculatePAndQAtSlackBus() {
 void PFSolverPowerPolar::calculateQAtPVBuses() {
         for (auto k: mPVBusIndices) {
         CPS::Complex I(0.0, 0.0);
-        for (UInt j = 0; j < mSystem.mNodes.size(); ++j) {
-            I += mY.coeff(k, j) * sol_Vcx(j);
+        for (SparseMatrixCompRow::InnerIterator it(mY, k); it; ++it) {
+            I += it.value() * sol_Vcx(it.col());
         }
         CPS::Complex S(0.0, 0.0);
         S = sol_Vcx(k) * conj(I);
@@ -7,18 +7,103 @@
  *********************************************************************************/
 
 #include <chrono>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
 #include <ctime>
 #include <dpsim/RealTimeSimulation.h>
 #include <iomanip>
 
+#ifdef __linux__
+  #include <alloca.h>
+  #include <malloc.h>
+  #include <pthread.h>
+  #include <sched.h>
+  #include <sys/mman.h>
+  #include <unistd.h>
+#endif
+
 using namespace CPS;
 using namespace DPsim;
 
 RealTimeSimulation::RealTimeSimulation(String name, Logger::Level logLevel)
-	: Simulation(name, logLevel), mTimer() {
+	: Simulation(name, logLevel), mTimer(),
+	mOverruns(Attribute<Int>::create("overruns", mAttributes, 0)),
+	mWakeUpLatency(Attribute<Real>::create("wakeup_latency", mAttributes, 0)),
+	mComputeTime(Attribute<Real>::create("compute_time", mAttributes, 0)),
+	mSlack(Attribute<Real>::create("slack", mAttributes, 0)),
+	mWakeUpLatencyStatistics(Attribute<TimingStatistics>::create("wakeup_latency_statistics", mAttributes)),
+	mComputeTimeStatistics(Attribute<TimingStatistics>::create("compute_time_statistics", mAttributes)),
+	mSlackStatistics(Attribute<TimingStatistics>::create("slack_statistics", mAttributes)) {
+}
 
-	//addAttribute<Int >("overruns", nullptr, [=](){ return mTimer.overruns(); }, Flags::read);
-	//addAttribute<Int >("overruns", nullptr, nullptr, Flags::read);
+#ifdef __linux__
+/// Touches every page of a stack region so that later steps do not fault
+static void prefaultStack(std::size_t size) {
+	volatile unsigned char* stack = static_cast<unsigned char*>(alloca(size));
+	std::size_t pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+	for (std::size_t i = 0; i < size; i += pageSize)
+		stack[i] = 0;
+}
+
+/// Touches every page of a heap region and keeps it in the allocator's pool
+static void prefaultHeap(std::size_t size) {
+#ifdef __GLIBC__
+	// Never return freed memory to the kernel and serve large allocations from the pool
+	mallopt(M_TRIM_THRESHOLD, -1);
+	mallopt(M_MMAP_MAX, 0);
+#endif
+	if (size == 0)
+		return;
+
+	volatile unsigned char* heap = static_cast<unsigned char*>(std::malloc(size));
+	if (heap == nullptr)
+		return;
+	std::size_t pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+	for (std::size_t i = 0; i < size; i += pageSize)
+		heap[i] = 0;
+	std::free(const_cast<unsigned char*>(heap));
+}
+#endif
+
+void RealTimeSimulation::applyProfile() {
+#ifdef __linux__
+	if (mProfile.cpu >= 0 && !Scheduler::pinCurrentThread(mProfile.cpu))
+		mLog->warn("Failed to pin simulation thread to CPU {}", mProfile.cpu);
+
+	if (mProfile.priority > 0) {
+		struct sched_param param = {};
+		param.sched_priority = mProfile.priority;
+		int ret = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+		if (ret != 0)
+			mLog->warn("Failed to set SCHED_FIFO priority {}: {}", mProfile.priority, std::strerror(ret));
+	}
+
+	if (mProfile.lockMemory && mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+		mLog->warn("Failed to lock memory: {}", std::strerror(errno));
+
+	prefaultHeap(mProfile.prefaultHeap);
+	prefaultStack(mProfile.prefaultStack);
+#else
+	mLog->warn("The real-time profile is only supported on Linux");
+#endif
+}
+
+void RealTimeSimulation::updateTimingStatistics(Timer::IntervalTimePoint wakeUp, Timer::IntervalTimePoint end) {
+	auto tick = mTimer.lastTick();
+	auto latency = wakeUp - tick;
+	auto compute = end - wakeUp;
+	auto slack = tick + mTimer.interval() - end;
+
+	**mOverruns = static_cast<Int>(mTimer.overruns());
+	**mWakeUpLatency = std::chrono::duration<Real>(latency).count();
+	**mComputeTime = std::chrono::duration<Real>(compute).count();
+	**mSlack = std::chrono::duration<Real>(slack).count();
+
+	// Negative slack is recorded as zero, the overruns attribute counts those steps
+	(**mWakeUpLatencyStatistics).add(latency);
+	(**mComputeTimeStatistics).add(compute);
+	(**mSlackStatistics).add(slack);
 }
 
 void RealTimeSimulation::run(const Timer::StartClock::duration &startIn) {
@@ -34,6 +119,14 @@ void RealTimeSimulation::run(const Timer::StartClock::time_point &startAt) {
 	for (auto intf : mInterfaces)
 		intf->open();
 
+	// Applied after all helper threads have been started, so that they
+	// do not inherit the priority and affinity of the simulation thread
+	if (mUseProfile) {
+		for (UInt i = 0; i < mInterfaces.size() && !mProfile.interfaceCpus.empty(); i++)
+			mInterfaces[i]->pinThreads(mProfile.interfaceCpus[i % mProfile.interfaceCpus.size()]);
+		applyProfile();
+	}
+
 	sync();
 
 	auto now_time = std::chrono::system_clock::to_time_t(startAt);
@@ -41,6 +134,14 @@ void RealTimeSimulation::run(const Timer::StartClock::time_point &startAt) {
 			  std::put_time(std::localtime(&now_time), "%F %T"),
 			  std::chrono::duration_cast<std::chrono::seconds>(startAt - Timer::StartClock::now()).count());
 
+	// The data of a step is touched ahead of time so that its page faults
+	// and cold caches do not count against the step budget. Time, step
+	// count and interfaces are left untouched.
+	if (mUseProfile && mProfile.warmUp) {
+		for (auto solver : mSolvers)
+			solver->warmUp();
+	}
+
 	mTimer.setStartTime(startAt);
 	mTimer.setInterval(**mTimeStep);
 	mTimer.start();
@@ -48,13 +149,19 @@ void RealTimeSimulation::run(const Timer::StartClock::time_point &startAt) {
 	// main loop
 	do {
 		mTimer.sleep();
+		auto wakeUp = Timer::IntervalClock::now();
 		step();
+		updateTimingStatistics(wakeUp, Timer::IntervalClock::now());
 
 		if (mTimer.ticks() == 1)
 			mLog->info("Simulation started.");
 	} while (mTime < **mFinalTime);
 
 	mLog->info("Simulation finished.");
+	mLog->info("Overruns: {}", **mOverruns);
+	mLog->info("Wake-up latency [ns]: {}", mWakeUpLatencyStatistics->toString());
+	mLog->info("Compute time [ns]: {}", mComputeTimeStatistics->toString());
+	mLog->info("Slack [ns]: {}", mSlackStatistics->toString());
 
 	mScheduler->stop();
 
@@ -8,36 +8,105 @@
 
 #include <dpsim/Scheduler.h>
 
+#include <climits>
 #include <fstream>
 #include <iostream>
 #include <unordered_map>
 #include <unordered_set>
 
+#ifdef __linux__
+  #include <linux/futex.h>
+  #include <pthread.h>
+  #include <sched.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+
 using namespace CPS;
 using namespace DPsim;
 
 CPS::AttributeBase::Ptr Scheduler::external;
 
+void DPsim::parkThread(std::atomic<Int>& word, Int value) {
+#ifdef __linux__
+	static_assert(sizeof(std::atomic<Int>) == sizeof(int), "futex requires a plain int");
+	syscall(SYS_futex, reinterpret_cast<int*>(&word), FUTEX_WAIT_PRIVATE, value, nullptr, nullptr, 0);
+#else
+	std::this_thread::yield();
+#endif
+}
+
+void DPsim::unparkThreads(std::atomic<Int>& word) {
+#ifdef __linux__
+	syscall(SYS_futex, reinterpret_cast<int*>(&word), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#endif
+}
+
+#ifdef __linux__
+static Bool pinPthread(pthread_t thread, Int cpu) {
+	cpu_set_t cpuset;
+	CPU_ZERO(&cpuset);
+	CPU_SET(cpu, &cpuset);
+	return pthread_setaffinity_np(thread, sizeof(cpuset), &cpuset) == 0;
+}
+#endif
+
+Bool Scheduler::pinCurrentThread(Int cpu) {
+#ifdef __linux__
+	return pinPthread(pthread_self(), cpu);
+#else
+	return false;
+#endif
+}
+
+Bool Scheduler::pinThread(std::thread& thread, Int cpu) {
+#ifdef __linux__
+	return thread.joinable() && pinPthread(thread.native_handle(), cpu);
+#else
+	return false;
+#endif
+}
+
 void Scheduler::initMeasurements(const Task::List& tasks) {
-	// Fill map here already since it's not protected by a mutex
+	// Allocate all statistics here already since they are not protected by a mutex
 	for (auto task : tasks) {
-		mMeasurements[task.get()] = std::vector<TaskTime>();
+		mMeasurements[measurementIndex(task.get())].reset();
 	}
 }
 
+UInt Scheduler::measurementIndex(Task* task) {
+	auto it = mMeasurementIndices.find(task);
+	if (it != mMeasurementIndices.end())
+		return it->second;
+
+	UInt index = static_cast<UInt>(mMeasurements.size());
+	mMeasurements.emplace_back();
+	mMeasuredTasks.push_back(task);
+	mMeasurementIndices[task] = index;
+	return index;
+}
+
 void Scheduler::updateMeasurement(Task* ptr, TaskTime time) {
-	mMeasurements[ptr].push_back(time);
+	auto it = mMeasurementIndices.find(ptr);
+	if (it != mMeasurementIndices.end())
+		mMeasurements[it->second].add(time);
 }
 
 void Scheduler::writeMeasurements(String filename) {
 	std::ofstream os(filename);
-	std::unordered_map<String, TaskTime> averages;
-	for (auto& pair : mMeasurements) {
-		averages[pair.first->toString()] = getAveragedMeasurement(pair.first);
-	}
-	// TODO think of nicer output format
-	for (auto pair : averages) {
-		os << pair.first << "," << pair.second.count() << std::endl;
+	// One line per task starting with name and average, which is all readMeasurements
+	// parses. Durations are in clock ticks, the standard deviation in nanoseconds.
+	for (UInt i = 0; i < mMeasurements.size(); i++) {
+		auto& meas = mMeasurements[i];
+		os << mMeasuredTasks[i]->toString() << ","
+			<< meas.mean().count() << ","
+			<< meas.min().count() << ","
+			<< meas.max().count() << ","
+			<< meas.stddev() << ","
+			<< meas.quantile(0.5).count() << ","
+			<< meas.quantile(0.99).count() << ","
+			<< meas.quantile(0.999).count() << ","
+			<< meas.count() << std::endl;
 	}
 	os.close();
 }
@@ -62,16 +131,19 @@ void Scheduler::readMeasurements(String filename, std::unordered_map<String, Tas
 }
 
 Scheduler::TaskTime Scheduler::getAveragedMeasurement(CPS::Task* task) {
-	TaskTime avg(0), tot(0);
+	auto it = mMeasurementIndices.find(task);
+	if (it == mMeasurementIndices.end())
+		return TaskTime(0);
 
-	for (TaskTime time : mMeasurements[task]) {
-		tot += time;
-	}
+	return std::chrono::duration_cast<TaskTime>(mMeasurements[it->second].mean());
+}
 
-	if (!mMeasurements[task].empty())
-		avg = tot / mMeasurements[task].size();
+TimingStatistics Scheduler::getMeasurementStatistics(CPS::Task::Ptr task) {
+	auto it = mMeasurementIndices.find(task.get());
+	if (it == mMeasurementIndices.end())
+		return TimingStatistics();
 
-	return avg;
+	return mMeasurements[it->second];
 }
 
 
@@ -24,17 +24,23 @@ void SequentialScheduler::createSchedule(const Task::List& tasks, const Edges& i
 		Scheduler::initMeasurements(tasks);
 	Scheduler::topologicalSort(tasks, inEdges, outEdges, mSchedule);
 
+	mScheduleMeasurements.clear();
+	if (mOutMeasurementFile.size() != 0) {
+		for (auto task : mSchedule)
+			mScheduleMeasurements.push_back(measurementIndex(task.get()));
+	}
+
 	for (auto task : mSchedule)
         mSLog->info("{}", task->toString());
 }
 
 void SequentialScheduler::step(Real time, Int timeStepCount) {
 	if (mOutMeasurementFile.size() != 0) {
-		for (auto task : mSchedule) {
+		for (size_t i = 0; i < mSchedule.size(); i++) {
 			auto start = std::chrono::steady_clock::now();
-			task->execute(time, timeStepCount);
+			mSchedule[i]->execute(time, timeStepCount);
 			auto end = std::chrono::steady_clock::now();
-			updateMeasurement(task.get(), end-start);
+			updateMeasurement(mScheduleMeasurements[i], end-start);
 		}
 	} else {
 		for (auto it : mSchedule) {
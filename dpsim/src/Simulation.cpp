@@ -11,6 +11,7 @@
 #include <dpsim-models/Utils.h>
 #include <dpsim/MNASolverFactory.h>
 #include <dpsim/PFSolverPowerPolar.h>
+#include <dpsim/DiakopticsPartitioner.h>
 #include <dpsim/DiakopticsSolver.h>
 
 #include <spdlog/sinks/stdout_color_sinks.h>
@@ -125,10 +126,73 @@ void Simulation::createSolvers() {
 #endif /* WITH_SUNDIALS */
 }
 
+template <typename VarType>
+std::shared_ptr<MnaSolver<VarType>> Simulation::createMNASolverImpl(String name, const SystemTopology& system) {
+	auto solver = MnaSolverFactory::factory<VarType>(name, mDomain,
+										 mLogLevel, mMnaImpl, mSolverPluginName);
+	solver->setTimeStep(**mTimeStep);
+	solver->doSteadyStateInit(**mSteadyStateInit);
+	solver->doFrequencyParallelization(mFreqParallel);
+	solver->setSteadStIniTimeLimit(mSteadStIniTimeLimit);
+	solver->setSteadStIniAccLimit(mSteadStIniAccLimit);
+	solver->setSystem(system);
+	solver->setSolverAndComponentBehaviour(mSolverBehaviour);
+	solver->doInitFromNodesAndTerminals(mInitFromNodesAndTerminals);
+	solver->doSystemMatrixRecomputation(mSystemMatrixRecomputation);
+	solver->doLazySwitchFactorization(mLazySwitchFactorization);
+	solver->setSwitchFactorizationCacheLimit(mSwitchFactorizationCacheLimit);
+	solver->doLowRankUpdates(mLowRankUpdates);
+	solver->setLowRankUpdateMaxRank(mLowRankUpdateMaxRank);
+	solver->doSchurComplementUpdates(mSchurComplementUpdates);
+	return solver;
+}
+
+template <typename VarType>
+void Simulation::createEnsembleMNASolver() {
+#ifdef WITH_SPARSE
+	if (mTearComponents.size() > 0 || mAutomaticTearing)
+		throw SystemError("Ensembles do not support diakoptics");
+
+	// All scenarios share the factorizations of the first solver, so the
+	// system is not split into subnets
+	auto leader = std::dynamic_pointer_cast<MnaSolverEigenSparse<VarType>>(
+		createMNASolverImpl<VarType>(**mName, mSystem));
+	if (!leader)
+		throw SystemError("Ensembles are only supported by the sparse MNA solvers");
+
+	std::vector<std::shared_ptr<MnaSolverEigenSparse<VarType>>> members;
+	for (UInt i = 0; i < mEnsemble.size(); ++i) {
+		auto member = std::dynamic_pointer_cast<MnaSolverEigenSparse<VarType>>(
+			createMNASolverImpl<VarType>(**mName + "_scenario_" + std::to_string(i + 1), mEnsemble[i]));
+		leader->addEnsembleMember(member);
+		members.push_back(member);
+	}
+
+	// Members compare their system matrices with the ones of the leader
+	leader->initialize();
+	mSolvers.push_back(leader);
+	for (auto member : members) {
+		member->initialize();
+		mSolvers.push_back(member);
+	}
+#else
+	throw SystemError("Ensembles require the sparse MNA solvers");
+#endif
+}
+
 template <typename VarType>
 void Simulation::createMNASolver() {
+	if (!mEnsemble.empty()) {
+		createEnsembleMNASolver<VarType>();
+		return;
+	}
+
 	Solver::Ptr solver;
 	std::vector<SystemTopology> subnets;
+	if (mAutomaticTearing && mTearComponents.size() == 0) {
+		DiakopticsPartitioner partitioner(mLogLevel);
+		mTearComponents = partitioner.partition<VarType>(mSystem, mAutomaticTearingSubnets, mAutomaticTearingThreads);
+	}
 	// The Diakoptics solver splits the system at a later point.
 	// That is why the system is not split here if tear components exist.
 	if (**mSplitSubnets && mTearComponents.size() == 0)
@@ -149,17 +213,7 @@ void Simulation::createMNASolver() {
 				subnets[net], mTearComponents, **mTimeStep, mLogLevel);
 		} else {
 			// Default case with lu decomposition from mna factory
-			solver = MnaSolverFactory::factory<VarType>(**mName + copySuffix, mDomain,
-												 mLogLevel, mMnaImpl, mSolverPluginName);
-			solver->setTimeStep(**mTimeStep);
-			solver->doSteadyStateInit(**mSteadyStateInit);
-			solver->doFrequencyParallelization(mFreqParallel);
-			solver->setSteadStIniTimeLimit(mSteadStIniTimeLimit);
-			solver->setSteadStIniAccLimit(mSteadStIniAccLimit);
-			solver->setSystem(subnets[net]);
-			solver->setSolverAndComponentBehaviour(mSolverBehaviour);
-			solver->doInitFromNodesAndTerminals(mInitFromNodesAndTerminals);
-			solver->doSystemMatrixRecomputation(mSystemMatrixRecomputation);
+			solver = createMNASolverImpl<VarType>(**mName + copySuffix, subnets[net]);
 			solver->initialize();
 		}
 		mSolvers.push_back(solver);
@@ -195,8 +249,16 @@ void Simulation::prepSchedule() {
 	}
 
 	for (auto logger : mLoggers) {
+		if (mAsyncLogging)
+			logger->enableAsync(mLogBufferRows, mLogFullBufferPolicy);
 		mTasks.push_back(logger->getTask());
 	}
+	if (mAsyncLogging) {
+		for (auto solver : mSolvers) {
+			for (auto logger : solver->loggers())
+				logger->enableAsync(mLogBufferRows, mLogFullBufferPolicy);
+		}
+	}
 	if (!mScheduler) {
 		mScheduler = std::make_shared<SequentialScheduler>();
 	}
@@ -396,22 +458,29 @@ Real Simulation::step() {
 	++mTimeStepCount;
 
 	auto end = std::chrono::steady_clock::now();
-	std::chrono::duration<double> diff = end-start;
-	mStepTimes.push_back(diff.count());
+	mStepTimeStatistics.add(end-start);
+	if (mRecordStepTimes) {
+		std::chrono::duration<double> diff = end-start;
+		mStepTimes.push_back(diff.count());
+	}
 	return mTime;
 }
 
 void Simulation::logStepTimes(String logName) {
-	auto stepTimeLog = Logger::get(logName, Logger::Level::info);
+	auto stepTimeLog = Logger::getDedicated(logName, Logger::Level::info);
 	Logger::setLogPattern(stepTimeLog, "%v");
 	stepTimeLog->info("step_time");
 
-	Real stepTimeSum = 0;
 	for (auto meas : mStepTimes) {
-		stepTimeSum += meas;
 		stepTimeLog->info("{:f}", meas);
 	}
-	mLog->info("Average step time: {:.6f}", stepTimeSum / mStepTimes.size());
+
+	auto& stats = mStepTimeStatistics;
+	auto seconds = [](TimingStatistics::Duration time) { return std::chrono::duration<double>(time).count(); };
+	mLog->info("Average step time: {:.6f}", seconds(stats.mean()));
+	mLog->info("Step time min/max: {:.6f}/{:.6f}, p50/p99/p99.9: {:.6f}/{:.6f}/{:.6f}",
+		seconds(stats.min()), seconds(stats.max()),
+		seconds(stats.quantile(0.5)), seconds(stats.quantile(0.99)), seconds(stats.quantile(0.999)));
 }
 
 CPS::AttributeBase::Ptr Simulation::getIdObjAttribute(const String &comp, const String &attr) {
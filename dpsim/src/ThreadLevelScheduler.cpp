@@ -24,7 +24,6 @@ void ThreadLevelScheduler::createSchedule(const Task::List& tasks, const Edges&
 	std::vector<Task::List> levels;
 
 	Scheduler::topologicalSort(tasks, inEdges, outEdges, ordered);
-	Scheduler::initMeasurements(ordered);
 
 	Scheduler::levelSchedule(ordered, inEdges, outEdges, levels);
 
@@ -21,7 +21,6 @@ void ThreadListScheduler::createSchedule(const Task::List& tasks, const Edges& i
 	Task::List ordered;
 
 	Scheduler::topologicalSort(tasks, inEdges, outEdges, ordered);
-	Scheduler::initMeasurements(ordered);
 
 	std::unordered_map<Task::Ptr, int64_t> priorities;
 	std::unordered_map<String, TaskTime::rep> measurements;
@@ -19,6 +19,12 @@ ThreadScheduler::ThreadScheduler(Int threads, String outMeasurementFile, Bool us
 		throw SchedulingException();
 	mTempSchedules.resize(threads);
 	mSchedules.resize(threads, nullptr);
+	mWaitTimes.resize(threads);
+}
+
+void ThreadScheduler::setWaitPolicy(const WaitPolicy& policy) {
+	mWaitPolicy = policy;
+	mStartBarrier.setWaitPolicy(policy);
 }
 
 ThreadScheduler::~ThreadScheduler() {
@@ -40,10 +46,15 @@ void ThreadScheduler::finishSchedule(const Edges& inEdges) {
 	//		void *ref = *(reinterpret_cast<void**>(refpos));
 	//		std::cout << entry.task->toString() << " " << ref << std::endl;
 	//	}
+		// Statistics are only allocated for the tasks when they are measured
+		Bool measure = !mOutMeasurementFile.empty();
+		if (measure)
+			Scheduler::initMeasurements(mTempSchedules[thread]);
 		mSchedules[thread] = new ScheduleEntry[mTempSchedules[thread].size()];
 		for (size_t i = 0; i < mTempSchedules[thread].size(); i++) {
 			auto& task = mTempSchedules[thread][i];
 			mSchedules[thread][i].task = task.get();
+			mSchedules[thread][i].measurementIdx = measure ? measurementIndex(task.get()) : 0;
 			counters[task] = &mSchedules[thread][i].endCounter;
 		}
 	}
@@ -66,13 +77,18 @@ void ThreadScheduler::step(Real time, Int timeStepCount) {
 	mTime = time;
 	mTimeStepCount = timeStepCount;
 	mStartBarrier.wait();
-	doStep(0);
+	TaskTime waitTime = doStep(0);
 	// since we don't have a final BarrierTask, wait for all threads to finish
 	// their last task explicitly
+	std::chrono::steady_clock::time_point start;
+	if (mMeasureWaitTimes)
+		start = std::chrono::steady_clock::now();
 	for (int thread = 1; thread < mNumThreads; thread++) {
 		if (mTempSchedules[thread].size() != 0)
-			mSchedules[thread][mTempSchedules[thread].size()-1].endCounter.wait(mTimeStepCount+1);
+			mSchedules[thread][mTempSchedules[thread].size()-1].endCounter.wait(mTimeStepCount+1, mWaitPolicy);
 	}
+	if (mMeasureWaitTimes)
+		mWaitTimes[0].add(waitTime + (std::chrono::steady_clock::now() - start));
 }
 
 void ThreadScheduler::stop() {
@@ -86,37 +102,65 @@ void ThreadScheduler::stop() {
 	if (!mOutMeasurementFile.empty()) {
 		writeMeasurements(mOutMeasurementFile);
 	}
+	if (mMeasureWaitTimes) {
+		for (int thread = 0; thread < mNumThreads; thread++) {
+			auto& stats = mWaitTimes[thread];
+			mSLog->info("Thread {} wait time per step [ns]: mean {}, p99 {}, max {}", thread,
+				stats.mean().count(), stats.quantile(0.99).count(), stats.max().count());
+		}
+	}
 }
 
 void ThreadScheduler::threadFunction(ThreadScheduler* sched, Int idx) {
+	if (!sched->mThreadAffinity.empty()) {
+		Int cpu = sched->mThreadAffinity[(idx-1) % sched->mThreadAffinity.size()];
+		if (!pinCurrentThread(cpu))
+			sched->mSLog->warn("Failed to pin thread {} to CPU {}", idx, cpu);
+	}
+
 	while (true) {
 		sched->mStartBarrier.wait();
 		if (sched->mJoining)
 			return;
 
-		sched->doStep(idx);
+		TaskTime waitTime = sched->doStep(idx);
+		if (sched->mMeasureWaitTimes)
+			sched->mWaitTimes[idx].add(waitTime);
 	}
 }
 
-void ThreadScheduler::doStep(Int thread) {
+void ThreadScheduler::waitForPredecessors(ScheduleEntry* entry, TaskTime& waitTime) {
+	if (!mMeasureWaitTimes) {
+		for (Counter* counter : entry->reqCounters)
+			counter->wait(mTimeStepCount+1, mWaitPolicy);
+		return;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	for (Counter* counter : entry->reqCounters)
+		counter->wait(mTimeStepCount+1, mWaitPolicy);
+	waitTime += std::chrono::steady_clock::now() - start;
+}
+
+Scheduler::TaskTime ThreadScheduler::doStep(Int thread) {
+	TaskTime waitTime(0);
 	if (mOutMeasurementFile.empty()) {
 		for (size_t i = 0; i != mTempSchedules[thread].size(); i++) {
 			ScheduleEntry* entry = &mSchedules[thread][i];
-			for (Counter* counter : entry->reqCounters)
-				counter->wait(mTimeStepCount+1);
+			waitForPredecessors(entry, waitTime);
 			entry->task->execute(mTime, mTimeStepCount);
 			entry->endCounter.inc();
 		}
 	} else {
 		for (size_t i = 0; i != mTempSchedules[thread].size(); i++) {
 			ScheduleEntry* entry = &mSchedules[thread][i];
-			for (Counter* counter : entry->reqCounters)
-				counter->wait(mTimeStepCount+1);
+			waitForPredecessors(entry, waitTime);
 			auto start = std::chrono::steady_clock::now();
 			entry->task->execute(mTime, mTimeStepCount);
 			auto end = std::chrono::steady_clock::now();
-			updateMeasurement(entry->task, end-start);
+			updateMeasurement(entry->measurementIdx, end-start);
 			entry->endCounter.inc();
 		}
 	}
+	return waitTime;
 }
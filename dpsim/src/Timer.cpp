@@ -107,7 +107,8 @@ void Timer::start() {
 		throw SystemError("Failed to arm timerfd");
 	}
 #endif
-	mNextTick = IntervalTimePoint(start) + mTickInterval;
+	mStartTick = IntervalTimePoint(start);
+	mNextTick = mStartTick + mTickInterval;
 	mState = State::running;
 }
 
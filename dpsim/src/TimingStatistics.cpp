@@ -0,0 +1,68 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/TimingStatistics.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace DPsim;
+
+void TimingStatistics::reset() {
+	mCount = 0;
+	mMin = 0;
+	mMax = 0;
+	mSum = 0;
+	mMean = 0;
+	mM2 = 0;
+	mBuckets.fill(0);
+}
+
+Real TimingStatistics::stddev() const {
+	if (mCount < 2)
+		return 0;
+	return std::sqrt(mM2 / static_cast<Real>(mCount - 1));
+}
+
+Real TimingStatistics::bucketValue(UInt bucket) {
+	if (bucket < SUB_BUCKETS)
+		return static_cast<Real>(bucket);
+	UInt exponent = bucket / SUB_BUCKETS + 2;
+	uint64_t width = uint64_t(1) << (exponent - 3);
+	uint64_t lower = (SUB_BUCKETS + bucket % SUB_BUCKETS) * width;
+	return static_cast<Real>(lower) + 0.5 * static_cast<Real>(width - 1);
+}
+
+TimingStatistics::Duration TimingStatistics::quantile(Real q) const {
+	if (mCount == 0)
+		return Duration(0);
+
+	q = std::min(std::max(q, 0.), 1.);
+	uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * static_cast<Real>(mCount))));
+
+	uint64_t seen = 0;
+	for (UInt bucket = 0; bucket < NUM_BUCKETS; ++bucket) {
+		seen += mBuckets[bucket];
+		if (seen >= rank) {
+			// The extreme buckets are bounded by the exact minimum and maximum
+			int64_t value = static_cast<int64_t>(std::llround(bucketValue(bucket)));
+			return Duration(std::min(std::max(value, mMin), mMax));
+		}
+	}
+	return Duration(mMax);
+}
+
+std::ostream& DPsim::operator<<(std::ostream& os, const TimingStatistics& stats) {
+	return os << "count " << stats.count()
+		<< ", mean " << stats.mean().count()
+		<< ", min " << stats.min().count()
+		<< ", p50 " << stats.quantile(0.5).count()
+		<< ", p99 " << stats.quantile(0.99).count()
+		<< ", p99.9 " << stats.quantile(0.999).count()
+		<< ", max " << stats.max().count();
+}
@@ -54,7 +54,7 @@ CommandLineArgs::CommandLineArgs(int argc, char *argv[],
 		{ "start-in",		required_argument,	0, 'i', "SECS", "" },
 		{ "solver-domain",	required_argument,	0, 'D', "(SP|DP|EMT)", "Domain of solver" },
 		{ "solver-type",	required_argument,	0, 'T', "(NRP|MNA)", "Type of solver" },
-		{ "solver-mna-impl", required_argument, 0, 'U', "(EigenDense|EigenSparse|CUDADense|CUDASparse)", "Type of MNA Solver implementation"},
+		{ "solver-mna-impl", required_argument, 0, 'U', "(EigenDense|EigenSparse|EigenSparseComplex|LeftLookingSparse|CUDADense|CUDASparse)", "Type of MNA Solver implementation"},
 		{ "option",		required_argument,	0, 'o', "KEY=VALUE", "User-definable options" },
 		{ "name",		required_argument,	0, 'n', "NAME", "Name of log files" },
 		{ "params",		required_argument,	0, 'p', "PATH", "Json file containing parametrization"},
@@ -109,7 +109,7 @@ CommandLineArgs::CommandLineArgs(
 		{ "start-in",		required_argument,	0, 'i', "SECS", "" },
 		{ "solver-domain",	required_argument,	0, 'D', "(SP|DP|EMT)", "Domain of solver" },
 		{ "solver-type",	required_argument,	0, 'T', "(NRP|MNA)", "Type of solver" },
-		{ "solver-mna-impl", required_argument, 0, 'U', "(EigenDense|EigenSparse|CUDADense|CUDASparse)", "Type of MNA Solver implementation"},
+		{ "solver-mna-impl", required_argument, 0, 'U', "(EigenDense|EigenSparse|EigenSparseComplex|LeftLookingSparse|CUDADense|CUDASparse)", "Type of MNA Solver implementation"},
 		{ "option",		required_argument,	0, 'o', "KEY=VALUE", "User-definable options" },
 		{ "name",		required_argument,	0, 'n', "NAME", "Name of log files" },
 		{ 0 }
@@ -238,6 +238,10 @@ void CommandLineArgs::parseArguments(int argc, char *argv[])
 					mnaImpl = MnaSolverFactory::EigenDense;
 				} else if (arg == "EigenSparse") {
 					mnaImpl = MnaSolverFactory::EigenSparse;
+				} else if (arg == "EigenSparseComplex") {
+					mnaImpl = MnaSolverFactory::EigenSparseComplex;
+				} else if (arg == "LeftLookingSparse") {
+					mnaImpl = MnaSolverFactory::LeftLookingSparse;
 				} else if (arg == "CUDADense") {
 					mnaImpl = MnaSolverFactory::CUDADense;
 				} else if (arg == "CUDASparse") {
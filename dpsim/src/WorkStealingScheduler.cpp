@@ -0,0 +1,230 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/WorkStealingScheduler.h>
+
+#include <algorithm>
+#include <chrono>
+#include <unordered_map>
+
+using namespace CPS;
+using namespace DPsim;
+
+void WorkStealingScheduler::TaskDeque::push(UInt task) {
+	acquire();
+	tasks[tail++] = task;
+	release();
+}
+
+Bool WorkStealingScheduler::TaskDeque::pop(UInt& task) {
+	acquire();
+	Bool found = head != tail;
+	if (found)
+		task = tasks[--tail];
+	release();
+	return found;
+}
+
+Bool WorkStealingScheduler::TaskDeque::steal(UInt& task) {
+	acquire();
+	Bool found = head != tail;
+	if (found)
+		task = tasks[head++];
+	release();
+	return found;
+}
+
+WorkStealingScheduler::WorkStealingScheduler(Int threads, String outMeasurementFile) :
+	mNumThreads(threads), mOutMeasurementFile(outMeasurementFile),
+	mStartBarrier(threads), mEndBarrier(threads), mRemainingTasks(0), mWorkSignal(0), mWorkParked(0) {
+	if (threads < 1)
+		throw SchedulingException();
+}
+
+WorkStealingScheduler::~WorkStealingScheduler() {
+	if (!mThreads.empty() && !mJoining) {
+		mJoining = true;
+		mStartBarrier.wait();
+		for (auto& thread : mThreads)
+			thread.join();
+	}
+}
+
+void WorkStealingScheduler::setWaitPolicy(const WaitPolicy& policy) {
+	mStartBarrier.setWaitPolicy(policy);
+	mEndBarrier.setWaitPolicy(policy);
+	mWaitPolicy = policy;
+}
+
+void WorkStealingScheduler::createSchedule(const Task::List& tasks, const Edges& inEdges, const Edges& outEdges) {
+	Task::List ordered;
+	Scheduler::topologicalSort(tasks, inEdges, outEdges, ordered);
+	if (!mOutMeasurementFile.empty())
+		Scheduler::initMeasurements(ordered);
+
+	std::unordered_map<Task::Ptr, UInt> indices;
+	mTasks.clear();
+	mTaskMeasurements.clear();
+	for (auto task : ordered) {
+		indices[task] = static_cast<UInt>(mTasks.size());
+		mTasks.push_back(task.get());
+		mTaskMeasurements.push_back(mOutMeasurementFile.empty() ? 0 : measurementIndex(task.get()));
+	}
+
+	// Successor lists without duplicate edges and without tasks that are not
+	// scheduled, e.g. the root task
+	UInt numTasks = static_cast<UInt>(mTasks.size());
+	mSuccessorOffsets.assign(1, 0);
+	mSuccessors.clear();
+	mNumPredecessors.assign(numTasks, 0);
+	for (auto task : ordered) {
+		UInt begin = static_cast<UInt>(mSuccessors.size());
+		auto it = outEdges.find(task);
+		if (it != outEdges.end()) {
+			for (auto after : it->second) {
+				auto succ = indices.find(after);
+				if (succ == indices.end())
+					continue;
+				if (std::find(mSuccessors.begin() + begin, mSuccessors.end(), succ->second) != mSuccessors.end())
+					continue;
+				mSuccessors.push_back(succ->second);
+				mNumPredecessors[succ->second]++;
+			}
+		}
+		mSuccessorOffsets.push_back(static_cast<UInt>(mSuccessors.size()));
+	}
+
+	mRootTasks.clear();
+	for (UInt task = 0; task < numTasks; task++) {
+		if (mNumPredecessors[task] == 0)
+			mRootTasks.push_back(task);
+	}
+
+	mPendingPredecessors.reset(new std::atomic<Int>[numTasks]);
+	mDeques.reset(new TaskDeque[mNumThreads]);
+	for (Int thread = 0; thread < mNumThreads; thread++)
+		mDeques[thread].tasks.reset(new UInt[std::max<UInt>(numTasks, 1)]);
+
+	for (auto task : mTasks)
+		mSLog->info("{}", task->toString());
+
+	if (mThreads.empty()) {
+		for (Int thread = 1; thread < mNumThreads; thread++)
+			mThreads.emplace_back(threadFunction, this, thread);
+	}
+}
+
+void WorkStealingScheduler::step(Real time, Int timeStepCount) {
+	mTime = time;
+	mTimeStepCount = timeStepCount;
+
+	for (UInt task = 0; task < mTasks.size(); task++)
+		mPendingPredecessors[task].store(mNumPredecessors[task], std::memory_order_relaxed);
+	for (Int thread = 0; thread < mNumThreads; thread++) {
+		mDeques[thread].head = 0;
+		mDeques[thread].tail = 0;
+	}
+	// Spread the tasks without predecessors so that all threads start working immediately
+	for (UInt i = 0; i < mRootTasks.size(); i++) {
+		auto& deque = mDeques[i % mNumThreads];
+		deque.tasks[deque.tail++] = mRootTasks[i];
+	}
+	mRemainingTasks.store(static_cast<Int>(mTasks.size()), std::memory_order_relaxed);
+
+	// The barriers publish the state above and collect all writes of the tasks
+	mStartBarrier.wait();
+	doStep(0);
+	mEndBarrier.wait();
+}
+
+void WorkStealingScheduler::stop() {
+	if (!mThreads.empty() && !mJoining) {
+		mJoining = true;
+		mStartBarrier.wait();
+		for (auto& thread : mThreads)
+			thread.join();
+		mThreads.clear();
+	}
+	if (!mOutMeasurementFile.empty())
+		writeMeasurements(mOutMeasurementFile);
+}
+
+void WorkStealingScheduler::threadFunction(WorkStealingScheduler* sched, Int idx) {
+	if (!sched->mThreadAffinity.empty()) {
+		Int cpu = sched->mThreadAffinity[(idx-1) % sched->mThreadAffinity.size()];
+		if (!pinCurrentThread(cpu))
+			sched->mSLog->warn("Failed to pin thread {} to CPU {}", idx, cpu);
+	}
+
+	while (true) {
+		sched->mStartBarrier.wait();
+		if (sched->mJoining)
+			return;
+
+		sched->doStep(idx);
+		sched->mEndBarrier.signal();
+	}
+}
+
+void WorkStealingScheduler::doStep(Int thread) {
+	while (true) {
+		UInt task;
+		Bool found = false;
+		waitFor(mWorkSignal, mWorkParked, mWaitPolicy, [this, thread, &task, &found]() {
+			found = takeTask(thread, task);
+			return found || mRemainingTasks.load(std::memory_order_acquire) == 0;
+		});
+		if (!found)
+			return;
+		executeTask(thread, task);
+	}
+}
+
+Bool WorkStealingScheduler::takeTask(Int thread, UInt& task) {
+	if (mDeques[thread].pop(task))
+		return true;
+	for (Int i = 1; i < mNumThreads; i++) {
+		if (mDeques[(thread + i) % mNumThreads].steal(task))
+			return true;
+	}
+	return false;
+}
+
+void WorkStealingScheduler::signalWork() {
+	// Sequentially consistent so that it cannot miss a thread parking
+	mWorkSignal.fetch_add(1, std::memory_order_seq_cst);
+	if (mWorkParked.load(std::memory_order_seq_cst) > 0)
+		unparkThreads(mWorkSignal);
+}
+
+void WorkStealingScheduler::executeTask(Int thread, UInt task) {
+	if (mOutMeasurementFile.empty()) {
+		mTasks[task]->execute(mTime, mTimeStepCount);
+	} else {
+		auto start = std::chrono::steady_clock::now();
+		mTasks[task]->execute(mTime, mTimeStepCount);
+		auto end = std::chrono::steady_clock::now();
+		updateMeasurement(mTaskMeasurements[task], end-start);
+	}
+
+	// The last finishing predecessor makes a successor ready. Keeping it on
+	// this thread preserves locality, idle threads will steal it otherwise.
+	Bool ready = false;
+	for (UInt i = mSuccessorOffsets[task]; i < mSuccessorOffsets[task+1]; i++) {
+		UInt succ = mSuccessors[i];
+		if (mPendingPredecessors[succ].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			mDeques[thread].push(succ);
+			ready = true;
+		}
+	}
+	Bool last = mRemainingTasks.fetch_sub(1, std::memory_order_acq_rel) == 1;
+
+	// Without parking, waiting threads poll the deques and need no signal
+	if (mWaitPolicy.park && (ready || last))
+		signalWork();
+}
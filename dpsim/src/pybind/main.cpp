@@ -53,6 +53,11 @@ PYBIND11_MODULE(dpsimpy, m) {
 		.value("critical", CPS::Logger::Level::critical)
 		.value("off", CPS::Logger::Level::off);
 
+	py::enum_<DPsim::DataLogger::FullBufferPolicy>(m, "FullBufferPolicy")
+		.value("Block", DPsim::DataLogger::FullBufferPolicy::Block)
+		.value("Drop", DPsim::DataLogger::FullBufferPolicy::Drop)
+		.value("Downsample", DPsim::DataLogger::FullBufferPolicy::Downsample);
+
 	py::class_<CPS::Math>(m, "Math")
 		.def_static("single_phase_variable_to_three_phase", &CPS::Math::singlePhaseVariableToThreePhase)
 		.def_static("single_phase_parameter_to_three_phase", &CPS::Math::singlePhaseParameterToThreePhase)
@@ -71,6 +76,8 @@ PYBIND11_MODULE(dpsimpy, m) {
 		.def("set_time_step", &DPsim::Simulation::setTimeStep)
 		.def("set_final_time", &DPsim::Simulation::setFinalTime)
 		.def("add_logger", &DPsim::Simulation::addLogger)
+		.def("do_step_time_recording", &DPsim::Simulation::doStepTimeRecording, "value"_a = true)
+		.def("do_async_logging", &DPsim::Simulation::doAsyncLogging, "value"_a, "buffer_rows"_a = 4096, "policy"_a = DPsim::DataLogger::FullBufferPolicy::Block)
 		.def("set_system", &DPsim::Simulation::setSystem)
 		.def("run", &DPsim::Simulation::run)
 		.def("set_solver", &DPsim::Simulation::setSolverType)
@@ -83,9 +90,16 @@ PYBIND11_MODULE(dpsimpy, m) {
 		.def("log_attribute", &DPsim::Simulation::logAttribute, "name"_a, "attr"_a)
 		.def("do_init_from_nodes_and_terminals", &DPsim::Simulation::doInitFromNodesAndTerminals)
 		.def("do_system_matrix_recomputation", &DPsim::Simulation::doSystemMatrixRecomputation)
+		.def("do_lazy_switch_factorization", &DPsim::Simulation::doLazySwitchFactorization)
+		.def("set_switch_factorization_cache_limit", &DPsim::Simulation::setSwitchFactorizationCacheLimit)
+		.def("do_low_rank_updates", &DPsim::Simulation::doLowRankUpdates)
+		.def("set_low_rank_update_max_rank", &DPsim::Simulation::setLowRankUpdateMaxRank)
+		.def("do_schur_complement_updates", &DPsim::Simulation::doSchurComplementUpdates)
+		.def("set_ensemble", &DPsim::Simulation::setEnsemble)
 		.def("do_steady_state_init", &DPsim::Simulation::doSteadyStateInit)
 		.def("do_frequency_parallelization", &DPsim::Simulation::doFrequencyParallelization)
 		.def("set_tearing_components", &DPsim::Simulation::setTearingComponents)
+		.def("set_automatic_tearing", &DPsim::Simulation::setAutomaticTearing, "subnets"_a, "threads"_a = 1)
 		.def("add_event", &DPsim::Simulation::addEvent)
 		.def("set_solver_component_behaviour", &DPsim::Simulation::setSolverAndComponentBehaviour)
 		.def("set_mna_solver_implementation", &DPsim::Simulation::setMnaSolverImplementation);
@@ -99,7 +113,18 @@ PYBIND11_MODULE(dpsimpy, m) {
 		.def("set_system", &DPsim::RealTimeSimulation::setSystem)
 		.def("run", static_cast<void (DPsim::RealTimeSimulation::*)(CPS::Int startIn)>(&DPsim::RealTimeSimulation::run))
 		.def("set_solver", &DPsim::RealTimeSimulation::setSolverType)
-		.def("set_domain", &DPsim::RealTimeSimulation::setDomain);
+		.def("set_domain", &DPsim::RealTimeSimulation::setDomain)
+		.def("set_realtime_profile", &DPsim::RealTimeSimulation::setRealTimeProfile, "profile"_a);
+
+	py::class_<DPsim::RealTimeSimulation::RealTimeProfile>(m, "RealTimeProfile")
+		.def(py::init<>())
+		.def_readwrite("priority", &DPsim::RealTimeSimulation::RealTimeProfile::priority)
+		.def_readwrite("cpu", &DPsim::RealTimeSimulation::RealTimeProfile::cpu)
+		.def_readwrite("interface_cpus", &DPsim::RealTimeSimulation::RealTimeProfile::interfaceCpus)
+		.def_readwrite("lock_memory", &DPsim::RealTimeSimulation::RealTimeProfile::lockMemory)
+		.def_readwrite("prefault_stack", &DPsim::RealTimeSimulation::RealTimeProfile::prefaultStack)
+		.def_readwrite("prefault_heap", &DPsim::RealTimeSimulation::RealTimeProfile::prefaultHeap)
+		.def_readwrite("warm_up", &DPsim::RealTimeSimulation::RealTimeProfile::warmUp);
 
 	py::class_<CPS::SystemTopology, std::shared_ptr<CPS::SystemTopology>>(m, "SystemTopology")
         .def(py::init<CPS::Real, CPS::TopologicalNode::List, CPS::IdentifiedObject::List>())
@@ -123,12 +148,17 @@ PYBIND11_MODULE(dpsimpy, m) {
 		.def("list_idobjects", &DPsim::SystemTopology::listIdObjects)
 		.def("init_with_powerflow", &DPsim::SystemTopology::initWithPowerflow);
 
-	py::class_<DPsim::Interface, std::shared_ptr<DPsim::Interface>>(m, "Interface");
+	py::class_<DPsim::Interface, std::shared_ptr<DPsim::Interface>>(m, "Interface")
+		.def("set_export_slots", &DPsim::Interface::setExportSlots, "num_slots"_a);
 
 	py::class_<DPsim::DataLogger, std::shared_ptr<DPsim::DataLogger>>(m, "Logger")
         .def(py::init<std::string>())
 		.def_static("set_log_dir", &CPS::Logger::setLogDir)
 		.def_static("get_log_dir", &CPS::Logger::logDir)
+		.def_static("set_shared_log_file", &CPS::Logger::setSharedLogFile)
+		.def_static("set_max_log_files", &CPS::Logger::setMaxLogFiles)
+		.def("enable_async", &DPsim::DataLogger::enableAsync, "buffer_rows"_a = 4096, "policy"_a = DPsim::DataLogger::FullBufferPolicy::Block)
+		.def("dropped_rows", &DPsim::DataLogger::droppedRows)
 		.def("log_attribute", py::overload_cast<const CPS::String&, CPS::AttributeBase::Ptr, CPS::UInt, CPS::UInt>(&DPsim::DataLogger::logAttribute), "name"_a, "attr"_a, "max_cols"_a = 0, "max_rows"_a = 0)
 		/// Compatibility method. Might be removed later when the python examples have been fully adapted.
 		.def("log_attribute", py::overload_cast<const std::vector<CPS::String>&, CPS::AttributeBase::Ptr>(&DPsim::DataLogger::logAttribute), "names"_a, "attr"_a)
@@ -141,6 +171,9 @@ PYBIND11_MODULE(dpsimpy, m) {
 			logger.logAttribute(names, comp.attribute(attr));
 		});
 
+	py::class_<DPsim::BinaryDataLogger, DPsim::DataLogger, std::shared_ptr<DPsim::BinaryDataLogger>>(m, "BinaryLogger")
+		.def(py::init<std::string, CPS::Bool, CPS::UInt, CPS::UInt>(), "name"_a, "enabled"_a = true, "downsampling"_a = 1, "block_rows"_a = 1024);
+
 	py::class_<CPS::IdentifiedObject, std::shared_ptr<CPS::IdentifiedObject>>(m, "IdentifiedObject")
 		.def("name", &CPS::IdentifiedObject::name)
 		/// CHECK: It would be nicer if all the attributes of an IdObject were bound as properties so they show up in the documentation and auto-completion.
@@ -190,6 +223,8 @@ PYBIND11_MODULE(dpsimpy, m) {
 		.value("Undef", DPsim::MnaSolverFactory::MnaSolverImpl::Undef)
 		.value("EigenDense", DPsim::MnaSolverFactory::MnaSolverImpl::EigenDense)
 		.value("EigenSparse", DPsim::MnaSolverFactory::MnaSolverImpl::EigenSparse)
+		.value("EigenSparseComplex", DPsim::MnaSolverFactory::MnaSolverImpl::EigenSparseComplex)
+		.value("LeftLookingSparse", DPsim::MnaSolverFactory::MnaSolverImpl::LeftLookingSparse)
 		.value("CUDADense", DPsim::MnaSolverFactory::MnaSolverImpl::CUDADense)
 		.value("CUDASparse", DPsim::MnaSolverFactory::MnaSolverImpl::CUDASparse)
 		.value("CUDAMagma", DPsim::MnaSolverFactory::MnaSolverImpl::CUDAMagma);
@@ -212,7 +247,8 @@ PYBIND11_MODULE(dpsimpy, m) {
 
 	py::class_<CPS::CSVReader>(m, "CSVReader")
 		.def(py::init<std::string, const std::string &, std::map<std::string, std::string> &, CPS::Logger::Level>())
-		.def("assignLoadProfile", &CPS::CSVReader::assignLoadProfile);
+		.def("assignLoadProfile", &CPS::CSVReader::assignLoadProfile)
+		.def("setStreaming", &CPS::CSVReader::setStreaming);
 
 	//Base Classes
 
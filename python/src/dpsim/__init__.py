@@ -1,9 +1,10 @@
 from . import matpower
 from .matpower import Reader
+from . import binarylog
 
 try:
     from dpsimpy import *
 except ImportError:  # pragma: no cover
     print('Error: Could not find dpsim C++ module.')
 
-__all__ = ['matpower']
+__all__ = ['matpower', 'binarylog']
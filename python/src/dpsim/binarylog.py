@@ -0,0 +1,91 @@
+"""Reader for the binary columnar files written by dpsim's BinaryLogger.
+
+Usage as converter: python -m dpsim.binarylog <file.bin> [<file.csv>]
+"""
+
+import struct
+import sys
+
+import numpy as np
+import pandas as pd
+
+MAGIC = b'DPSIMLOG'
+VERSION = 1
+
+TYPE_REAL = 0
+TYPE_INT = 1
+TYPE_UINT = 2
+TYPE_BOOL = 3
+
+
+def read(path):
+    """Reads a binary log file into a DataFrame with a 'time' column
+    followed by the logged attributes in the order of the CSV logger."""
+    with open(path, 'rb') as f:
+        content = f.read()
+
+    if content[:8] != MAGIC:
+        raise ValueError('{} is not a binary dpsim log'.format(path))
+    version, num_columns = struct.unpack_from('<II', content, 8)
+    if version != VERSION:
+        raise ValueError('Unsupported binary log version {}'.format(version))
+
+    offset = 16
+    names = []
+    types = []
+    for _ in range(num_columns):
+        col_type, name_length = struct.unpack_from('<BI', content, offset)
+        offset += 5
+        names.append(content[offset:offset + name_length].decode('utf-8'))
+        types.append(col_type)
+        offset += name_length
+
+    blocks = [[] for _ in range(num_columns + 1)]
+    while offset < len(content):
+        num_rows, = struct.unpack_from('<I', content, offset)
+        offset += 4
+        for col in range(num_columns + 1):
+            blocks[col].append(np.frombuffer(content, dtype='<f8', count=num_rows, offset=offset))
+            offset += 8 * num_rows
+
+    data = {}
+    for col, name in enumerate(['time'] + names):
+        values = np.concatenate(blocks[col]) if blocks[col] else np.empty(0)
+        if col > 0 and types[col - 1] != TYPE_REAL:
+            values = values.astype(np.int64)
+        data[name] = values
+
+    return pd.DataFrame(data, columns=['time'] + names)
+
+
+def to_csv(path, csv_path):
+    """Converts a binary log file to the CSV format written by DataLogger."""
+    df = read(path)
+    names = list(df.columns[1:])
+    columns = [df[name].to_numpy() for name in names]
+    times = df['time'].to_numpy()
+
+    with open(csv_path, 'w') as f:
+        f.write('{:>14}'.format('time'))
+        for name in names:
+            f.write(', {:>13}'.format(name))
+        f.write('\n')
+
+        for row in range(len(times)):
+            f.write('{:>14.6e}'.format(times[row]))
+            for values in columns:
+                if values.dtype == np.int64:
+                    f.write(', {:>13}'.format('{:d}'.format(values[row])))
+                else:
+                    f.write(', {:>13}'.format('{:f}'.format(values[row])))
+            f.write('\n')
+
+
+if __name__ == '__main__':
+    if len(sys.argv) < 2:
+        print('Usage: python -m dpsim.binarylog <file.bin> [<file.csv>]')
+        sys.exit(1)
+
+    bin_path = sys.argv[1]
+    csv_path = sys.argv[2] if len(sys.argv) > 2 else bin_path.rsplit('.', 1)[0] + '.csv'
+    to_csv(bin_path, csv_path)